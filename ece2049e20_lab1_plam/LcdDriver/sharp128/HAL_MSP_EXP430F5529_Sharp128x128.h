@@ -55,6 +55,7 @@
 
 #include <stdint.h>
 #include <msp430.h>
+#include "clock.h"
 
 //*****************************************************************************
 //
@@ -100,17 +101,19 @@
 #define SPI_REG_STAT    UCB0STAT
 #define SPI_REG_TXBUF   UCB0TXBUF
 #define SPI_REG_RXBUF   UCB0RXBUF
+#define SPI_REG_IE      UCB0IE
+#define SPI_VECTOR      USCI_B0_VECTOR
 
 /*
  * UCSI SPI Clock parameters
  * The actual clock frequency is given in number of
  * ticks of the specified clock source.
  *
- * For our configuration, we use the same frequency
- * as SMCLK, which is 1.25MHz.
+ * SMCLK is divided down to LCD_SPI_FREQ_HZ; both are
+ * configured in clock.h.
  */
 #define SPI_CLK_SRC     (UCSSEL__SMCLK)
-#define SPI_CLK_TICKS   0
+#define SPI_CLK_TICKS   LCD_SPI_CLK_TICKS
 
 // LCD Screen Dimensions
 //#define LCD_VERTICAL_MAX                   128
@@ -139,6 +142,12 @@
 // Non-volatile Memory used to store DisplayBuffer
 //#define NON_VOLATILE_MEMORY_BUFFER
 
+// Double-buffered flush. grlib draws into DisplayBuffer; a flush copies the
+// rows that changed into a front buffer and the SPI TX interrupt sends them
+// while drawing continues. Comment out for the blocking full-frame flush.
+// SMCLK clocks the SPI, so the transfer pauses while the CPU is in LPM3.
+#define LCD_DOUBLE_BUFFER
+
 //*****************************************************************************
 //
 // Prototypes for the globals exported by this driver.
@@ -153,5 +162,9 @@ extern void HAL_LCD_finishMemoryWrite(void);
 extern void HAL_LCD_waitUntilLcdWriteFinish(void);
 extern void HAL_LCD_disableDisplay(void);
 extern void HAL_LCD_enableDisplay(void);
+#ifdef LCD_DOUBLE_BUFFER
+extern void HAL_LCD_enableTxInterrupt(void);
+extern void HAL_LCD_disableTxInterrupt(void);
+#endif
 
 #endif // __HAL_MSP_EXP430FR5969_SHARPLCD_H__
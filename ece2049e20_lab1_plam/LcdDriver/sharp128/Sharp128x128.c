@@ -62,15 +62,22 @@
 #include "HAL_MSP_EXP430F5529_Sharp128x128.h"
 #endif
 #include <stdint.h>
+#include "utils/profile.h"
 
 const uint8_t reverse_data[] = {0x0, 0x8, 0x4, 0xC, 0x2, 0xA, 0x6, 0xE, 0x1,
                                 0x9, 0x5, 0xD, 0x3, 0xB, 0x7, 0xF};
-static uint8_t VCOMbit = 0x40;
-static uint8_t flagSendToggleVCOMCommand = 0;
+static volatile uint8_t VCOMbit = 0x40;
+static volatile uint8_t flagSendToggleVCOMCommand = 0;
+
+// Set while a CS frame is on the bus. A VCOM toggle that arrives during a
+// frame is deferred until the frame ends so it never interleaves with it.
+static volatile uint8_t lcdBusy = 0;
+static volatile uint8_t vcomDeferred = 0;
 
 static void Sharp128x128_InitializeDisplayBuffer(void *pvDisplayData,
                                                uint8_t ucValue);
 static uint8_t Sharp128x128_reverse(uint8_t x);
+static void Sharp128x128_endFrame(void);
 
 //*****************************************************************************
 //
@@ -92,10 +99,106 @@ __persistent uint8_t DisplayBuffer[LCD_VERTICAL_MAX +32][LCD_HORIZONTAL_MAX/8] =
 #else
 #error Compiler not supported!
 #endif //__TI_COMPILER_VERSION__
+#elif defined(LCD_DOUBLE_BUFFER)
+// USBRAM only holds one frame; the front buffer goes there
+uint8_t DisplayBuffer[LCD_VERTICAL_MAX][LCD_HORIZONTAL_MAX/8];
+#ifdef LCD_BUFFER_USBRAM
+#pragma DATA_SECTION(FrontBuffer, ".lcdbuf")
+#endif //LCD_BUFFER_USBRAM
+static uint8_t FrontBuffer[LCD_VERTICAL_MAX][LCD_HORIZONTAL_MAX/8];
 #else
+#ifdef LCD_BUFFER_USBRAM
+#pragma DATA_SECTION(DisplayBuffer, ".lcdbuf")
+#endif //LCD_BUFFER_USBRAM
 uint8_t DisplayBuffer[LCD_VERTICAL_MAX][LCD_HORIZONTAL_MAX/8];
 #endif //NON_VOLATILE_MEMORY_BUFFER
 
+//*****************************************************************************
+//
+// Row indirection. Logical row y (the row grlib draws to and the line
+// address sent to the panel) lives in buffer row (y + Sharp128x128_rowBase)
+// mod LCD_VERTICAL_MAX, so Sharp128x128_scroll() moves the picture by
+// changing the row base and only has to fill the rows that come into view.
+// The row base is exported for the Sharp128x128_row() macro.
+//
+//*****************************************************************************
+#if (LCD_VERTICAL_MAX & (LCD_VERTICAL_MAX - 1)) != 0
+#error "Row indirection needs LCD_VERTICAL_MAX to be a power of two"
+#endif
+
+#define ROW(y)          (((y) + Sharp128x128_rowBase) & (LCD_VERTICAL_MAX - 1))
+
+uint8_t Sharp128x128_rowBase = 0;
+
+#ifdef LCD_DOUBLE_BUFFER
+//*****************************************************************************
+//
+// Double buffering. Drawing marks rows in dirtyRows; a flush copies those
+// rows from DisplayBuffer to FrontBuffer, moves the set to frameRows and
+// starts sending it. From there the SPI TX interrupt walks frameRows one
+// byte at a time, so only the rows that changed are sent and the foreground
+// is free to draw the next frame into DisplayBuffer.
+//
+//*****************************************************************************
+#define LCD_ROW_WORDS   (LCD_VERTICAL_MAX / 16)
+
+#define MARK_ROW(y)     (dirtyRows[(y) >> 4] |= (1U << ((y) & 0xF)))
+
+typedef enum
+{
+    TX_ADDRESS,
+    TX_DATA,
+    TX_TRAILER,
+    TX_END
+} txPhases;
+
+static uint16_t dirtyRows[LCD_ROW_WORDS];
+static uint16_t frameRows[LCD_ROW_WORDS];
+static volatile uint8_t flushBusy = 0;
+static txPhases txPhase;
+static uint8_t txRow;
+static uint8_t txCount;
+static const uint8_t *txData;
+
+static void Sharp128x128_markRows(int16_t y1, int16_t y2);
+static void Sharp128x128_swapBuffers(void);
+#else
+#define MARK_ROW(y)     do {} while (0)
+#define Sharp128x128_markRows(y1, y2)   do {} while (0)
+#endif //LCD_DOUBLE_BUFFER
+
+//*****************************************************************************
+//
+// Rotation. With ROTATE_90 grlib still draws into DisplayBuffer in its own
+// orientation, so every primitive, images included, runs the same code as
+// in landscape. The picture is turned on its way to the panel: panel rows
+// 8m to 8m+7 are logical byte column 15-m, built by transposing the 16
+// 8x8 blocks of that column (Sharp128x128_rotateStrip). Dirty rows are
+// kept in panel rows, so drawing at logical x marks panel row 127-x.
+//
+//*****************************************************************************
+#ifdef ROTATE_90
+#if LCD_VERTICAL_MAX != LCD_HORIZONTAL_MAX
+#error "ROTATE_90 needs a square panel"
+#endif
+#ifdef LANDSCAPE_FLIP
+#error "ROTATE_90 is only implemented on top of LANDSCAPE"
+#endif
+
+#define MARK_SPAN(x1, x2, y1, y2) \
+    Sharp128x128_markRows(LCD_HORIZONTAL_MAX - 1 - (x2), \
+                          LCD_HORIZONTAL_MAX - 1 - (x1))
+
+#ifndef LCD_DOUBLE_BUFFER
+// Eight rotated panel rows, rebuilt by the flush every eighth row
+static uint8_t rotateStrip[8][LCD_HORIZONTAL_MAX >> 3];
+#endif
+
+static void Sharp128x128_rotateStrip(uint8_t strip, uint8_t *dst);
+#else
+#define MARK_SPAN(x1, x2, y1, y2)   Sharp128x128_markRows((y1), (y2))
+#endif //ROTATE_90
+
 //*****************************************************************************
 //
 //! Initializes the display driver.
@@ -116,13 +219,24 @@ void Sharp128x128_initDisplay(void)
 //! Send toggle VCOM command.
 //!
 //! This function toggles the state of VCOM which prevents a DC bias from being
-//! built up within the panel.
+//! built up within the panel. It is called from the Timer A1 interrupt.
+//!
+//! The new VCOM state rides on the command byte of the next flush or clear.
+//! The change VCOM command is only sent if no frame went out since the last
+//! toggle, i.e. the screen is idle. If a frame is on the bus when this runs,
+//! the toggle is deferred to the end of that frame.
 //!
 //! \return None.
 //
 //*****************************************************************************
 void Sharp128x128_SendToggleVCOMCommand()
 {
+    if(lcdBusy)
+    {
+        vcomDeferred = 1;
+        return;
+    }
+
     VCOMbit ^= SHARP_VCOM_TOGGLE_BIT;
 
     if(SHARP_SEND_TOGGLE_VCOM_COMMAND == flagSendToggleVCOMCommand)
@@ -132,6 +246,7 @@ void Sharp128x128_SendToggleVCOMCommand()
         //COM inversion bit
         command = command ^ VCOMbit;
 
+        lcdBusy = 1;
         HAL_LCD_setCS();
 
         HAL_LCD_writeCommandOrData(command);
@@ -141,14 +256,282 @@ void Sharp128x128_SendToggleVCOMCommand()
         HAL_LCD_waitUntilLcdWriteFinish();
 
         // Ensure a 2us min delay to meet the LCD's thSCS
-        __delay_cycles(SYSTEM_CLOCK_SPEED * 0.000002);
+        __delay_cycles(LCD_CS_HOLD_CYCLES);
 
         HAL_LCD_clearCS();
+        lcdBusy = 0;
     }
 
     flagSendToggleVCOMCommand = SHARP_SEND_TOGGLE_VCOM_COMMAND;
 }
 
+//*****************************************************************************
+//
+// Ends a flush or clear frame and applies a VCOM toggle that was deferred
+// while it was on the bus. A frame was just sent, so the deferred toggle
+// only flips VCOMbit for the next frame and costs no SPI traffic.
+//
+//*****************************************************************************
+static void Sharp128x128_endFrame(void)
+{
+    uint16_t sr = __get_SR_register();
+
+    __disable_interrupt();
+    lcdBusy = 0;
+    if(vcomDeferred)
+    {
+        vcomDeferred = 0;
+        Sharp128x128_SendToggleVCOMCommand();
+    }
+    __bis_SR_register(sr & GIE);
+}
+
+//*****************************************************************************
+//
+//! Reports whether an interrupt-driven flush is still on the bus.
+//!
+//! \return 1 while a flush started by Graphics_flushBuffer() is being sent,
+//! otherwise 0. Always 0 without LCD_DOUBLE_BUFFER.
+//
+//*****************************************************************************
+uint8_t Sharp128x128_isFlushBusy(void)
+{
+#ifdef LCD_DOUBLE_BUFFER
+    return(flushBusy);
+#else
+    return(0);
+#endif
+}
+
+//*****************************************************************************
+//
+//! Waits until an interrupt-driven flush has finished. Needs GIE.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void Sharp128x128_waitFlush(void)
+{
+#ifdef LCD_DOUBLE_BUFFER
+    while(flushBusy)
+    {
+        ;
+    }
+#endif
+}
+
+//*****************************************************************************
+//
+//! Scrolls the whole screen vertically.
+//!
+//! \param rows is the number of lines to move the picture by. Positive
+//! values move it up and bring new lines in at the bottom; negative values
+//! move it down and bring them in at the top.
+//! \param ulValue is the color the new lines are filled with, e.g. ClrWhite.
+//!
+//! Only the new lines are written; the rest of the buffer is reused by moving
+//! the row base, so the cost does not depend on the screen height. Every line
+//! of the panel changes, so the next flush sends the whole frame. Rows are
+//! grlib rows, so the picture moves vertically with ROTATE_90 as well.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void Sharp128x128_scroll(int16_t rows,
+                         uint32_t ulValue)
+{
+    uint8_t fill = (ClrBlack == ulValue) ? SHARP_BLACK : SHARP_WHITE;
+    int16_t first, count, yi;
+    uint8_t xi;
+
+    if(rows == 0)
+    {
+        return;
+    }
+
+    if(rows > 0)
+    {
+        count = (rows < LCD_VERTICAL_MAX) ? rows : LCD_VERTICAL_MAX;
+        first = LCD_VERTICAL_MAX - count;
+    }
+    else
+    {
+        count = (-rows < LCD_VERTICAL_MAX) ? -rows : LCD_VERTICAL_MAX;
+        first = 0;
+    }
+
+    Sharp128x128_rowBase = (Sharp128x128_rowBase + rows) & (LCD_VERTICAL_MAX - 1);
+
+#ifdef NON_VOLATILE_MEMORY_BUFFER
+    HAL_LCD_prepareMemoryWrite();
+#endif
+
+    for(yi = first; yi < first + count; yi++)
+    {
+        for(xi = 0; xi < (LCD_HORIZONTAL_MAX >> 3); xi++)
+        {
+            DisplayBuffer[ROW(yi)][xi] = fill;
+        }
+    }
+
+#ifdef NON_VOLATILE_MEMORY_BUFFER
+    HAL_LCD_finishMemoryWrite();
+#endif
+
+    Sharp128x128_markRows(0, LCD_VERTICAL_MAX - 1);
+}
+
+#ifdef LCD_DOUBLE_BUFFER
+//*****************************************************************************
+//
+// Marks rows y1 to y2 (inclusive) as changed since the last flush
+//
+//*****************************************************************************
+static void Sharp128x128_markRows(int16_t y1,
+                                  int16_t y2)
+{
+    while(y1 <= y2)
+    {
+        if(((y1 & 0xF) == 0) && ((y2 - y1) >= 15))
+        {
+            dirtyRows[y1 >> 4] = 0xFFFF;
+            y1 += 16;
+        }
+        else
+        {
+            MARK_ROW(y1);
+            y1++;
+        }
+    }
+}
+
+//*****************************************************************************
+//
+// Copies the changed rows of DisplayBuffer into FrontBuffer and starts
+// sending them. The caller makes sure no flush is in progress. Does nothing
+// if no row changed.
+//
+//*****************************************************************************
+static void Sharp128x128_swapBuffers(void)
+{
+    uint16_t changed = 0;
+    uint8_t yi;
+#ifndef ROTATE_90
+    uint8_t xi;
+#endif
+
+    for(yi = 0; yi < LCD_ROW_WORDS; yi++)
+    {
+        frameRows[yi] = dirtyRows[yi];
+        dirtyRows[yi] = 0;
+        changed |= frameRows[yi];
+    }
+    if(!changed)
+    {
+        return;
+    }
+
+#ifdef ROTATE_90
+    // Strips are rebuilt whole, so all eight rows of a touched strip are sent
+    for(yi = 0; yi < (LCD_VERTICAL_MAX >> 3); yi++)
+    {
+        uint16_t mask = 0xFFU << ((yi & 1) << 3);
+
+        if(frameRows[yi >> 1] & mask)
+        {
+            frameRows[yi >> 1] |= mask;
+            Sharp128x128_rotateStrip(yi, &FrontBuffer[yi << 3][0]);
+        }
+    }
+#else
+    for(yi = 0; yi < LCD_VERTICAL_MAX; yi++)
+    {
+        if(frameRows[yi >> 4] & (1U << (yi & 0xF)))
+        {
+            for(xi = 0; xi < (LCD_HORIZONTAL_MAX >> 3); xi++)
+            {
+                FrontBuffer[yi][xi] = DisplayBuffer[ROW(yi)][xi];
+            }
+        }
+    }
+#endif
+
+    flushBusy = 1;
+    lcdBusy = 1; //Set before VCOMbit is read so a toggle cannot split the frame
+
+    txRow = 0;
+    txPhase = TX_ADDRESS;
+
+    HAL_LCD_setCS();
+
+    //image update mode(1X000000b) with the COM inversion bit
+    HAL_LCD_writeCommandOrData(SHARP_LCD_CMD_WRITE_LINE ^ VCOMbit);
+    flagSendToggleVCOMCommand = SHARP_SKIP_TOGGLE_VCOM_COMMAND;
+
+    HAL_LCD_enableTxInterrupt();
+}
+
+//*****************************************************************************
+//
+// Called from the SPI TX interrupt with TXBUF empty. Sends the next byte of
+// the frame: for every row in frameRows its address, 16 data bytes and a
+// trailer, then the closing trailer. After that the frame is closed and the
+// interrupt is disabled.
+//
+//*****************************************************************************
+void Sharp128x128_txReady(void)
+{
+    switch(txPhase)
+    {
+    case TX_ADDRESS:
+        while((txRow < LCD_VERTICAL_MAX) &&
+              !(frameRows[txRow >> 4] & (1U << (txRow & 0xF))))
+        {
+            txRow++;
+        }
+        if(txRow == LCD_VERTICAL_MAX)
+        {
+            HAL_LCD_writeCommandOrData(SHARP_LCD_TRAILER_BYTE);
+            txPhase = TX_END;
+            break;
+        }
+        HAL_LCD_writeCommandOrData(Sharp128x128_reverse(txRow + 1));
+        txData = &FrontBuffer[txRow][0];
+        txCount = LCD_HORIZONTAL_MAX >> 3;
+        txPhase = TX_DATA;
+        break;
+
+    case TX_DATA:
+        HAL_LCD_writeCommandOrData(*txData++);
+        if(--txCount == 0)
+        {
+            txPhase = TX_TRAILER;
+        }
+        break;
+
+    case TX_TRAILER:
+        HAL_LCD_writeCommandOrData(SHARP_LCD_TRAILER_BYTE);
+        txRow++;
+        txPhase = TX_ADDRESS;
+        break;
+
+    case TX_END:
+        HAL_LCD_disableTxInterrupt();
+
+        // Wait for last byte to be sent, then drop SCS
+        HAL_LCD_waitUntilLcdWriteFinish();
+
+        // Ensure a 2us min delay to meet the LCD's thSCS
+        __delay_cycles(LCD_CS_HOLD_CYCLES);
+
+        HAL_LCD_clearCS();
+        Sharp128x128_endFrame();
+        flushBusy = 0;
+        break;
+    }
+}
+#endif //LCD_DOUBLE_BUFFER
+
 void Sharp128x128_disable(void)
 {
     HAL_LCD_disableDisplay();
@@ -175,6 +558,74 @@ static uint8_t Sharp128x128_reverse(uint8_t x)
     return(b);
 }
 
+#ifdef ROTATE_90
+//*****************************************************************************
+//
+// Transposes an 8x8 bit matrix in place. Row r is a[r], most significant bit
+// first; afterwards a[c] holds column c, row 0 in the most significant bit.
+// Swaps the off-diagonal 4x4, then 2x2, then 1x1 blocks using only byte
+// shifts of 1, 2 and 4, which the MSP430 does without a barrel shifter.
+//
+//*****************************************************************************
+static void Sharp128x128_transpose8(uint8_t *a)
+{
+    uint8_t r, t;
+
+    for(r = 0; r < 4; r++)
+    {
+        t = (a[r] ^ (a[r + 4] >> 4)) & 0x0F;
+        a[r] ^= t;
+        a[r + 4] ^= t << 4;
+    }
+    for(r = 0; r < 6; r++)
+    {
+        if(r & 2)
+        {
+            continue;
+        }
+        t = (a[r] ^ (a[r + 2] >> 2)) & 0x33;
+        a[r] ^= t;
+        a[r + 2] ^= t << 2;
+    }
+    for(r = 0; r < 8; r += 2)
+    {
+        t = (a[r] ^ (a[r + 1] >> 1)) & 0x55;
+        a[r] ^= t;
+        a[r + 1] ^= t << 1;
+    }
+}
+
+//*****************************************************************************
+//
+// Builds panel rows 8*strip to 8*strip+7 into dst, 8 rows of
+// LCD_HORIZONTAL_MAX/8 bytes. Panel row 8*strip+r shows logical column
+// x = 127-8*strip-r, and its byte b holds logical rows 8b to 8b+7.
+//
+//*****************************************************************************
+static void Sharp128x128_rotateStrip(uint8_t strip,
+                                     uint8_t *dst)
+{
+    uint8_t block[8];
+    uint8_t column = ((LCD_HORIZONTAL_MAX >> 3) - 1) - strip;
+    uint8_t bx, k;
+
+    for(bx = 0; bx < (LCD_VERTICAL_MAX >> 3); bx++)
+    {
+        for(k = 0; k < 8; k++)
+        {
+            block[k] = DisplayBuffer[ROW((bx << 3) + k)][column];
+        }
+        Sharp128x128_transpose8(block);
+
+        // block[j] is logical column 8*column+j, i.e. panel row 8*strip+7-j
+        for(k = 0; k < 8; k++)
+        {
+            dst[(7 - k) * (LCD_HORIZONTAL_MAX >> 3) + bx] = block[k];
+        }
+    }
+}
+#endif //ROTATE_90
+
 //*****************************************************************************
 //
 //! Initialize DisplayBuffer.
@@ -240,11 +691,7 @@ static void Sharp128x128_PixelDraw(void *pvDisplayData,
                                  int16_t lY,
                                  uint16_t ulValue)
 {
-#ifdef ROTATE_90
-    uint16_t temp = lX;
-    lX = lY;
-    lY = LCD_HORIZONTAL_MAX - temp - 1;
-#endif
+    MARK_SPAN(lX, lX, lY, lY);
 
 #ifdef NON_VOLATILE_MEMORY_BUFFER
     HAL_LCD_prepareMemoryWrite();
@@ -252,11 +699,15 @@ static void Sharp128x128_PixelDraw(void *pvDisplayData,
 
     if(ClrBlack == ulValue)
     {
-        DisplayBuffer[lY][lX >> 3] &= ~(0x80 >> (lX & 0x7));
+        DisplayBuffer[ROW(lY)][lX >> 3] &= ~(0x80 >> (lX & 0x7));
+    }
+    else if(SHARP_COLOR_INVERT == ulValue)
+    {
+        DisplayBuffer[ROW(lY)][lX >> 3] ^= (0x80 >> (lX & 0x7));
     }
     else
     {
-        DisplayBuffer[lY][lX >> 3] |= (0x80 >> (lX & 0x7));
+        DisplayBuffer[ROW(lY)][lX >> 3] |= (0x80 >> (lX & 0x7));
     }
 
 #ifdef NON_VOLATILE_MEMORY_BUFFER
@@ -264,6 +715,108 @@ static void Sharp128x128_PixelDraw(void *pvDisplayData,
 #endif
 }
 
+//*****************************************************************************
+//
+// Shifts the next source byte of Sharp128x128_blitRow() into the window and
+// evaluates to the frame buffer byte it completes, in the requested colors
+//
+//*****************************************************************************
+#define BLIT_NEXT() \
+    (uiWindow = (uiWindow << 8) | ((lLeft-- > 0) ? *pucData++ : 0), \
+     (((uint8_t)(uiWindow >> ucShift) & ucMask) ^ ucBack))
+
+//*****************************************************************************
+//
+//! Copies a run of 1 bit per pixel image data into a row of the buffer.
+//!
+//! \param lX is the X coordinate of the first pixel.
+//! \param lY is the Y coordinate of the row.
+//! \param lX0 is the bit of the first data byte the run starts at, 0 being
+//! the most significant bit.
+//! \param lCount is the number of pixels to copy.
+//! \param pucData is a pointer to the pixel data, most significant bit
+//! leftmost.
+//! \param ucFore is the byte set bits are written as, SHARP_WHITE or
+//! SHARP_BLACK.
+//! \param ucBack is the byte clear bits are written as.
+//!
+//! The data is shifted into place through a 16 bit window, so each buffer
+//! byte is written once whatever the alignment of lX and lX0, and when both
+//! start on the same bit the middle bytes are plain copies. Only the first
+//! and last byte are merged with the pixels already in the row. The run must
+//! be within the extents of the display and is not marked for the next
+//! flush. Rows are the logical rows grlib draws to, so this also works
+//! unchanged with ROTATE_90.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void Sharp128x128_blitRow(int16_t lX,
+                          int16_t lY,
+                          int16_t lX0,
+                          int16_t lCount,
+                          const uint8_t *pucData,
+                          uint8_t ucFore,
+                          uint8_t ucBack)
+{
+    uint8_t *pucRow = &DisplayBuffer[ROW(lY)][lX >> 3];
+    int16_t lLast = lX + lCount - 1;
+    int16_t xi = (lLast >> 3) - (lX >> 3);
+    int16_t lLeft = ((lX0 + lCount - 1) >> 3) + 1;
+    uint8_t ucFirst = 0xFF >> (lX & 0x7);
+    uint8_t ucEnd = 0xFF << (7 - (lLast & 0x7));
+    uint8_t ucMask = ucFore ^ ucBack;
+    uint8_t ucShift, ucOut;
+    uint16_t uiWindow = 0;
+
+    if(lX0 > (lX & 0x7))
+    {
+        //The run starts further into its first byte than into the row, so
+        //the first buffer byte takes bits from two data bytes
+        uiWindow = *pucData++;
+        lLeft--;
+        ucShift = 8 + (lX & 0x7) - lX0;
+    }
+    else
+    {
+        ucShift = (lX & 0x7) - lX0;
+    }
+
+    if(xi == 0)
+    {
+        ucFirst &= ucEnd;
+    }
+    ucOut = BLIT_NEXT();
+    *pucRow = (*pucRow & ~ucFirst) | (ucOut & ucFirst);
+    if(xi == 0)
+    {
+        return;
+    }
+    pucRow++;
+
+    //write middle bytes
+    if(ucShift == 0)
+    {
+        //Aligned: data bytes map onto buffer bytes one to one, and lLeft
+        //stays positive for the last byte
+        for(; xi > 1; xi--)
+        {
+            *pucRow++ = (*pucData++ & ucMask) ^ ucBack;
+        }
+    }
+    else
+    {
+        for(; xi > 1; xi--)
+        {
+            *pucRow++ = BLIT_NEXT();
+        }
+    }
+
+    //write last byte
+    ucOut = BLIT_NEXT();
+    *pucRow = (*pucRow & ~ucEnd) | (ucOut & ucEnd);
+}
+
 //*****************************************************************************
 //
 //! Draws a horizontal sequence of pixels on the screen.
@@ -286,6 +839,9 @@ static void Sharp128x128_PixelDraw(void *pvDisplayData,
 //! contains 24-bit RGB values that must be translated before being written to
 //! the display.
 //!
+//! 1 bit per pixel runs may start at any lX and lX0; they are copied a byte
+//! at a time by Sharp128x128_blitRow().
+//!
 //! \return None.
 //
 //*****************************************************************************
@@ -298,21 +854,47 @@ static void Sharp128x128_DrawMultiple(void *pvDisplayData,
                                     const uint8_t *pucData,
                                     const uint32_t *pucPalette)
 {
-    uint8_t *pData = &DisplayBuffer[lY][lX >> 3];
-    uint16_t xj = 0;
+    int16_t xj;
+    uint8_t ucIndex;
+
+    MARK_SPAN(lX, lX + lCount - 1, lY, lY);
 
 #ifdef NON_VOLATILE_MEMORY_BUFFER
     HAL_LCD_prepareMemoryWrite();
 #endif
 
-    //Write bytes of data to the display buffer
-    for(xj = 0; xj < (lCount >> 3); xj++)
+    if(lBPP == 1)
     {
-        *pData++ = *pucData++;
+        Sharp128x128_blitRow(lX, lY, lX0, lCount, pucData,
+                             pucPalette[1] ? SHARP_WHITE : SHARP_BLACK,
+                             pucPalette[0] ? SHARP_WHITE : SHARP_BLACK);
     }
+    else
+    {
+        //4 and 8 bit per pixel data is drawn a pixel at a time; any palette
+        //color but black is white, as in Sharp128x128_ColorTranslate()
+        for(xj = 0; xj < lCount; xj++, lX++)
+        {
+            if(lBPP == 4)
+            {
+                ucIndex = pucData[(lX0 + xj) >> 1];
+                ucIndex = ((lX0 + xj) & 1) ? (ucIndex & 0x0F) : (ucIndex >> 4);
+            }
+            else
+            {
+                ucIndex = pucData[xj];
+            }
 
-    //Write last data byte to the display buffer
-    *pData = (*pData & (0xFF >> (lCount & 0x7))) | *pucData;
+            if(ClrBlack == pucPalette[ucIndex])
+            {
+                DisplayBuffer[ROW(lY)][lX >> 3] &= ~(0x80 >> (lX & 0x7));
+            }
+            else
+            {
+                DisplayBuffer[ROW(lY)][lX >> 3] |= (0x80 >> (lX & 0x7));
+            }
+        }
+    }
 
 #ifdef NON_VOLATILE_MEMORY_BUFFER
     HAL_LCD_finishMemoryWrite();
@@ -342,18 +924,13 @@ static void Sharp128x128_LineDrawH(void *pvDisplayData,
                                  int16_t lY,
                                  uint16_t ulValue)
 {
-#ifdef ROTATE_90
-    uint16_t temp = lX1;
-    lX1 = lX2;
-    lX2 = lY;
-    lY = LCD_HORIZONTAL_MAX - temp - 1;
-#endif
-
     uint16_t xi = 0;
     uint16_t x_index_min = lX1 >> 3;
     uint16_t x_index_max = lX2 >> 3;
     uint8_t *pucData, ucfirst_x_byte, uclast_x_byte;
 
+    MARK_SPAN(lX1, lX2, lY, lY);
+
 #ifdef NON_VOLATILE_MEMORY_BUFFER
     HAL_LCD_prepareMemoryWrite();
 #endif
@@ -369,7 +946,7 @@ static void Sharp128x128_LineDrawH(void *pvDisplayData,
     if(x_index_min != x_index_max)
     {
         //set buffer to correct location
-        pucData = &DisplayBuffer[lY][x_index_min];
+        pucData = &DisplayBuffer[ROW(lY)][x_index_min];
 
         //black pixels (clear bits)
         if(ClrBlack == ulValue)
@@ -386,6 +963,21 @@ static void Sharp128x128_LineDrawH(void *pvDisplayData,
             //write last byte
             *pucData &= ~uclast_x_byte;
         }
+        //inverted pixels (toggle bits)
+        else if(SHARP_COLOR_INVERT == ulValue)
+        {
+            //write first byte
+            *pucData++ ^= ucfirst_x_byte;
+
+            //write middle bytes
+            for(xi = x_index_min; xi < x_index_max - 1; xi++)
+            {
+                *pucData++ ^= 0xFF;
+            }
+
+            //write last byte
+            *pucData ^= uclast_x_byte;
+        }
         //white pixels (set bits)
         else
         {
@@ -409,13 +1001,18 @@ static void Sharp128x128_LineDrawH(void *pvDisplayData,
         ucfirst_x_byte &= uclast_x_byte;
 
         //set buffer to correct location
-        pucData = &DisplayBuffer[lY][x_index_min];
+        pucData = &DisplayBuffer[ROW(lY)][x_index_min];
 
         //draw black pixels (clear bits)
         if(ClrBlack == ulValue)
         {
             *pucData++ &= ~ucfirst_x_byte;
         }
+        //inverted pixels (toggle bits)
+        else if(SHARP_COLOR_INVERT == ulValue)
+        {
+            *pucData++ ^= ucfirst_x_byte;
+        }
         //white pixels (set bits)
         else
         {
@@ -451,17 +1048,12 @@ static void Sharp128x128_LineDrawV(void *pvDisplayData,
                                  int16_t lY2,
                                  uint16_t ulValue)
 {
-#ifdef ROTATE_90
-    uint16_t temp = lY2;
-    lY2 = LCD_HORIZONTAL_MAX - lX  - 1;
-    lY1 = LCD_HORIZONTAL_MAX - lY1 - 1;
-    lX = temp;
-#endif
-
     uint16_t yi = 0;
     uint16_t x_index = lX >> 3;
     uint8_t data_byte;
 
+    MARK_SPAN(lX, lX, lY1, lY2);
+
 #ifdef NON_VOLATILE_MEMORY_BUFFER
     HAL_LCD_prepareMemoryWrite();
 #endif
@@ -476,12 +1068,17 @@ static void Sharp128x128_LineDrawV(void *pvDisplayData,
         //black pixels (clear bits)
         if(ClrBlack == ulValue)
         {
-            DisplayBuffer[yi][x_index] &= ~data_byte;
+            DisplayBuffer[ROW(yi)][x_index] &= ~data_byte;
+        }
+        //inverted pixels (toggle bits)
+        else if(SHARP_COLOR_INVERT == ulValue)
+        {
+            DisplayBuffer[ROW(yi)][x_index] ^= data_byte;
         }
         //white pixels (set bits)
         else
         {
-            DisplayBuffer[yi][x_index] |= data_byte;
+            DisplayBuffer[ROW(yi)][x_index] |= data_byte;
         }
     }
 
@@ -511,25 +1108,14 @@ static void Sharp128x128_RectFill(void *pvDisplayData,
                                 const Graphics_Rectangle *pRect,
                                 uint16_t ulValue)
 {
-#ifdef ROTATE_90
-    // Make a new rectangle with transposed coordinates
-    tRectangle tempRect = *pRect;
-
-    tempRect.sXMin = pRect->sYMin;
-    tempRect.sXMax = pRect->sYMax;
-    tempRect.sYMin = LCD_HORIZONTAL_MAX - pRect->sXMax - 1;
-    tempRect.sYMax = LCD_HORIZONTAL_MAX - pRect->sXMin - 1;
-
-    // Set the pointer to the rectangle to the transposed version
-    pRect = &tempRect;
-#endif
-
     uint16_t xi = 0;
     uint16_t yi = 0;
     uint16_t x_index_min = pRect->sXMin >> 3;
     uint16_t x_index_max = pRect->sXMax >> 3;
     uint8_t *pucData, ucfirst_x_byte, uclast_x_byte;
 
+    MARK_SPAN(pRect->sXMin, pRect->sXMax, pRect->sYMin, pRect->sYMax);
+
 #ifdef NON_VOLATILE_MEMORY_BUFFER
     HAL_LCD_prepareMemoryWrite();
 #endif
@@ -549,7 +1135,7 @@ static void Sharp128x128_RectFill(void *pvDisplayData,
         for(yi = pRect->sYMin; yi <= pRect->sYMax; yi++)
         {
             //set buffer to correct location
-            pucData = &DisplayBuffer[yi][x_index_min];
+            pucData = &DisplayBuffer[ROW(yi)][x_index_min];
 
             //black pixels (clear bits)
             if(ClrBlack == ulValue)
@@ -566,6 +1152,21 @@ static void Sharp128x128_RectFill(void *pvDisplayData,
                 //write last byte
                 *pucData &= ~uclast_x_byte;
             }
+            //inverted pixels (toggle bits)
+            else if(SHARP_COLOR_INVERT == ulValue)
+            {
+                //write first byte
+                *pucData++ ^= ucfirst_x_byte;
+
+                //write middle bytes
+                for(xi = x_index_min; xi < x_index_max - 1; xi++)
+                {
+                    *pucData++ ^= 0xFF;
+                }
+
+                //write last byte
+                *pucData ^= uclast_x_byte;
+            }
             //white pixels (set bits)
             else
             {
@@ -589,18 +1190,26 @@ static void Sharp128x128_RectFill(void *pvDisplayData,
         //calculate value of single byte
         ucfirst_x_byte &= uclast_x_byte;
 
-        //set buffer to correct location
-        pucData = &DisplayBuffer[pRect->sYMin][x_index_min];
-
-        //black pixels (clear bits)
-        if(ClrBlack == ulValue)
-        {
-            *pucData++ &= ~ucfirst_x_byte;
-        }
-        //white pixels (set bits)
-        else
+        for(yi = pRect->sYMin; yi <= pRect->sYMax; yi++)
         {
-            *pucData++ |= ucfirst_x_byte;
+            //set buffer to correct location
+            pucData = &DisplayBuffer[ROW(yi)][x_index_min];
+
+            //black pixels (clear bits)
+            if(ClrBlack == ulValue)
+            {
+                *pucData &= ~ucfirst_x_byte;
+            }
+            //inverted pixels (toggle bits)
+            else if(SHARP_COLOR_INVERT == ulValue)
+            {
+                *pucData ^= ucfirst_x_byte;
+            }
+            //white pixels (set bits)
+            else
+            {
+                *pucData |= ucfirst_x_byte;
+            }
         }
     }
 
@@ -623,7 +1232,8 @@ static void Sharp128x128_RectFill(void *pvDisplayData,
 //! into the display's frame buffer in order to reproduce that color, or the
 //! closest possible approximation of that color. This particular driver
 //! requires the 8-8-8 24 bit RGB color to convert into mono color
-//! 1 = White, 0 = Black
+//! 1 = White, 0 = Black. ClrInvert becomes SHARP_COLOR_INVERT, which the
+//! drawing functions apply by toggling pixels.
 //!
 //! \return Returns the display-driver specific color
 //
@@ -631,6 +1241,11 @@ static void Sharp128x128_RectFill(void *pvDisplayData,
 static uint32_t Sharp128x128_ColorTranslate(void *pvDisplayData,
                                           uint32_t ulValue)
 {
+    if(ClrInvert == ulValue)
+    {
+        return(SHARP_COLOR_INVERT);
+    }
+
     //
     // Translate from a 24-bit RGB color to mono color.
     //
@@ -654,12 +1269,24 @@ static uint32_t Sharp128x128_ColorTranslate(void *pvDisplayData,
 //*****************************************************************************
 static void Sharp128x128_Flush(void *pvDisplayData)
 {
-    uint8_t *pucData = &DisplayBuffer[0][0];
+#ifdef LCD_DOUBLE_BUFFER
+    // Only the copy into the front buffer is done here; the rows go out
+    // from the SPI interrupt
+    PROFILE_BEGIN(PROF_FLUSH);
+    Sharp128x128_waitFlush();
+    Sharp128x128_swapBuffers();
+    PROFILE_END(PROF_FLUSH);
+#else
+    uint8_t *pucData;
     int32_t xi = 0;
     int32_t xj = 0;
     //image update mode(1X000000b)
     uint8_t command = SHARP_LCD_CMD_WRITE_LINE;
 
+    PROFILE_BEGIN(PROF_FLUSH);
+
+    lcdBusy = 1; //Set before VCOMbit is read so a toggle cannot split the frame
+
     //COM inversion bit
     command = command ^ VCOMbit;
 
@@ -672,6 +1299,15 @@ static void Sharp128x128_Flush(void *pvDisplayData)
     {
         HAL_LCD_writeCommandOrData(Sharp128x128_reverse(xj + 1));
 
+#ifdef ROTATE_90
+        if((xj & 7) == 0)
+        {
+            Sharp128x128_rotateStrip(xj >> 3, &rotateStrip[0][0]);
+        }
+        pucData = &rotateStrip[xj & 7][0];
+#else
+        pucData = &DisplayBuffer[ROW(xj)][0];
+#endif
         for(xi = 0; xi < (LCD_HORIZONTAL_MAX >> 3); xi++)
         {
             HAL_LCD_writeCommandOrData(*(pucData++));
@@ -680,13 +1316,13 @@ static void Sharp128x128_Flush(void *pvDisplayData)
     }
 #endif
 #ifdef LANDSCAPE_FLIP
-    pucData =
-        &DisplayBuffer[LCD_VERTICAL_MAX - 1][(LCD_HORIZONTAL_MAX >> 3) - 1];
-
     for(xj = 1; xj <= LCD_VERTICAL_MAX; xj++)
     {
         HAL_LCD_writeCommandOrData(Sharp128x128_reverse(xj));
 
+        pucData = &DisplayBuffer[ROW(LCD_VERTICAL_MAX - xj)]
+                                [(LCD_HORIZONTAL_MAX >> 3) - 1];
+
         for(xi = 0; xi < (LCD_HORIZONTAL_MAX >> 3); xi++)
         {
             HAL_LCD_writeCommandOrData(Sharp128x128_reverse(*pucData--));
@@ -701,9 +1337,13 @@ static void Sharp128x128_Flush(void *pvDisplayData)
     HAL_LCD_waitUntilLcdWriteFinish();
 
     // Ensure a 2us min delay to meet the LCD's thSCS
-    __delay_cycles(SYSTEM_CLOCK_SPEED * 0.000002);
+    __delay_cycles(LCD_CS_HOLD_CYCLES);
 
     HAL_LCD_clearCS();
+    Sharp128x128_endFrame();
+
+    PROFILE_END(PROF_FLUSH);
+#endif //LCD_DOUBLE_BUFFER
 }
 
 //*****************************************************************************
@@ -724,6 +1364,16 @@ static void Sharp128x128_ClearScreen(void *pvDisplayData,
 {
     //clear screen mode(0X100000b)
     uint8_t command = SHARP_LCD_CMD_CLEAR_SCREEN;
+#ifdef LCD_DOUBLE_BUFFER
+    uint8_t yi;
+#endif
+
+    PROFILE_BEGIN(PROF_CLEAR_SCREEN);
+
+    Sharp128x128_waitFlush(); //The clear command cannot share the bus with a flush
+
+    lcdBusy = 1; //Set before VCOMbit is read so a toggle cannot split the frame
+
     //COM inversion bit
     command = command ^ VCOMbit;
 
@@ -737,9 +1387,11 @@ static void Sharp128x128_ClearScreen(void *pvDisplayData,
     HAL_LCD_waitUntilLcdWriteFinish();
 
     // Ensure a 2us min delay to meet the LCD's thSCS
-    __delay_cycles(SYSTEM_CLOCK_SPEED * 0.000002);
+    __delay_cycles(LCD_CS_HOLD_CYCLES);
 
     HAL_LCD_clearCS();
+    Sharp128x128_endFrame();
+
     if(ClrBlack == ulValue)
     {
         Sharp128x128_InitializeDisplayBuffer(pvDisplayData, SHARP_BLACK);
@@ -748,6 +1400,77 @@ static void Sharp128x128_ClearScreen(void *pvDisplayData,
     {
         Sharp128x128_InitializeDisplayBuffer(pvDisplayData, SHARP_WHITE);
     }
+
+#ifdef LCD_DOUBLE_BUFFER
+    if(ClrBlack == ulValue)
+    {
+        // The clear command always leaves the panel white, so every row of
+        // a black buffer has to be sent
+        Sharp128x128_markRows(0, LCD_VERTICAL_MAX - 1);
+    }
+    else
+    {
+        // The panel already matches the cleared buffer, so rows drawn
+        // before the clear need not be sent. FrontBuffer is only read for
+        // rows the next flush copies, so it does not have to be cleared.
+        for(yi = 0; yi < LCD_ROW_WORDS; yi++)
+        {
+            dirtyRows[yi] = 0;
+        }
+    }
+#endif
+
+    PROFILE_END(PROF_CLEAR_SCREEN);
+}
+
+//*****************************************************************************
+//
+//! Marks an area written directly through Sharp128x128_row().
+//!
+//! \param lX1 is the X coordinate of the left edge of the area.
+//! \param lX2 is the X coordinate of the right edge of the area.
+//! \param lY1 is the Y coordinate of the top edge of the area.
+//! \param lY2 is the Y coordinate of the bottom edge of the area.
+//!
+//! The area is inclusive and must be within the extents of the display.
+//! Without LCD_DOUBLE_BUFFER every flush sends the whole frame and this
+//! does nothing.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void Sharp128x128_markSpan(int16_t lX1,
+                           int16_t lX2,
+                           int16_t lY1,
+                           int16_t lY2)
+{
+    MARK_SPAN(lX1, lX2, lY1, lY2);
+}
+
+//*****************************************************************************
+//
+//! Clears the screen and the buffer to ulValue. Same as the clear entry of
+//! g_sharp128x128LCD, for callers that bind to this driver directly.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void Sharp128x128_clearDisplay(uint16_t ulValue)
+{
+    Sharp128x128_ClearScreen(DisplayBuffer, ulValue);
+}
+
+//*****************************************************************************
+//
+//! Sends the buffer to the panel. Same as the flush entry of
+//! g_sharp128x128LCD, for callers that bind to this driver directly.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void Sharp128x128_flushBuffer(void)
+{
+    Sharp128x128_Flush(DisplayBuffer);
 }
 
 //*****************************************************************************
@@ -764,13 +1487,8 @@ const Graphics_Display g_sharp128x128LCD =
     LCD_VERTICAL_MAX,
     Sharp128x128_PixelDraw, //PixelDraw,
     Sharp128x128_DrawMultiple,
-#ifdef ROTATE_90
-    Sharp128x128_LineDrawV,
-    Sharp128x128_LineDrawH, //LineDrawV,
-#else
     Sharp128x128_LineDrawH,
     Sharp128x128_LineDrawV, //LineDrawV,
-#endif
     Sharp128x128_RectFill, //RectFill,
     Sharp128x128_ColorTranslate,
     Sharp128x128_Flush, //Flush
@@ -39,6 +39,7 @@
 #define __SHARP128x128_H__
 
 #include "grlib.h"
+#include "clock.h"
 
 //*****************************************************************************
 //
@@ -46,8 +47,9 @@
 //
 //*****************************************************************************
 
-// SYSTEM_CLOCK_SPEED (in Hz) allows to properly closeout SPI communication
-#define SYSTEM_CLOCK_SPEED      12000000
+// SYSTEM_CLOCK_SPEED (in Hz) allows to properly closeout SPI communication.
+// It follows the MCLK setting in clock.h.
+#define SYSTEM_CLOCK_SPEED      MCLK_FREQ_HZ
 
 // LCD Screen Dimensions
 #define LCD_VERTICAL_MAX                   128
@@ -55,11 +57,19 @@
 
 // Define LCD Screen Orientation Here
 #define LANDSCAPE
+// Turns the picture by 90 degrees. Drawing is unchanged; the driver
+// transposes the frame buffer in 8x8 blocks as it sends it.
 //#define ROTATE_90
 
 //Maximum Colors in an image color palette
 #define MAX_PALETTE_COLORS  2
 
+// Place DisplayBuffer in the .lcdbuf section, which the linker command file
+// maps to USBRAM (0x1C00, 2 KB). That bank is plain RAM while the USB module
+// is off, so the 2 KB frame buffer no longer comes out of main RAM.
+// Comment out to keep the buffer in .bss.
+#define LCD_BUFFER_USBRAM
+
 //*****************************************************************************
 //
 // Macros for the Display Driver
@@ -67,6 +77,12 @@
 //*****************************************************************************
 #define SHARP_BLACK                                                     0x00
 #define SHARP_WHITE                                                     0xFF
+
+// Pseudo color outside the 24-bit RGB range. Pixels drawn in it by fills,
+// lines and text are inverted, so drawing the same thing again restores
+// them. Graphics_setForegroundColor() stores it as SHARP_COLOR_INVERT.
+#define ClrInvert                                                       0x01000000
+#define SHARP_COLOR_INVERT                                              2
 #define SHARP_SEND_TOGGLE_VCOM_COMMAND          0x01
 #define SHARP_SKIP_TOGGLE_VCOM_COMMAND          0x00
 #define SHARP_LCD_TRAILER_BYTE                          0x00
@@ -86,4 +102,33 @@ extern void Sharp128x128_SendToggleVCOMCommand(void);
 extern void Sharp128x128_initDisplay(void);
 extern void Sharp128x128_disable(void);
 extern void Sharp128x128_enable(void);
+extern uint8_t Sharp128x128_isFlushBusy(void);
+extern void Sharp128x128_waitFlush(void);
+extern void Sharp128x128_scroll(int16_t rows, uint32_t ulValue);
+
+//*****************************************************************************
+//
+// Direct frame buffer access, for drawing code that binds to this driver at
+// compile time (gfx.c) instead of calling through g_sharp128x128LCD.
+// Sharp128x128_row(y) is the 16 byte row that holds logical line y; the
+// most significant bit of each byte is the leftmost pixel and a set bit is
+// white. Every area written this way has to be passed to
+// Sharp128x128_markSpan() so the next flush sends it.
+//
+//*****************************************************************************
+#ifndef NON_VOLATILE_MEMORY_BUFFER
+extern uint8_t DisplayBuffer[LCD_VERTICAL_MAX][LCD_HORIZONTAL_MAX/8];
+extern uint8_t Sharp128x128_rowBase;
+
+#define Sharp128x128_row(y) \
+    (DisplayBuffer[((y) + Sharp128x128_rowBase) & (LCD_VERTICAL_MAX - 1)])
+
+extern void Sharp128x128_markSpan(int16_t lX1, int16_t lX2,
+                                  int16_t lY1, int16_t lY2);
+#endif
+extern void Sharp128x128_blitRow(int16_t lX, int16_t lY, int16_t lX0,
+                                 int16_t lCount, const uint8_t *pucData,
+                                 uint8_t ucFore, uint8_t ucBack);
+extern void Sharp128x128_clearDisplay(uint16_t ulValue);
+extern void Sharp128x128_flushBuffer(void);
 #endif // __SHARP128x128_H__
@@ -97,8 +97,8 @@ void Sharp96x96_Init(void)
 	// Configure the SPI interface on USCI B0
     USCI_B_SPI_masterInit(USCI_B0_BASE,
                     USCI_B_SPI_CLOCKSOURCE_SMCLK,
-					8000000,
-                    1000000,
+					SMCLK_FREQ_HZ,
+                    LCD_SPI_FREQ_HZ,
                     USCI_B_SPI_MSB_FIRST,
                     USCI_B_SPI_PHASE_DATA_CAPTURED_ONFIRST_CHANGED_ON_NEXT,
                     USCI_B_SPI_CLOCKPOLARITY_INACTIVITY_LOW);
@@ -138,7 +138,7 @@ void Sharp96x96_Init(void)
 
 	SPI_REG_CTL1 |= SPI_CLK_SRC; // Select SMCLK for our clock source
 
-	// Set SPI clock frequency (which is the same frequency as SMCLK so this can apparently be 0)
+	// Set SPI clock frequency (SMCLK / SPI_CLK_TICKS)
 	SPI_REG_BRL  =  ((uint16_t)SPI_CLK_TICKS) & 0xFF;         // Load the low byte
 	SPI_REG_BRH  = (((uint16_t)SPI_CLK_TICKS) >> 8) & 0xFF;	  // Load the high byte
 
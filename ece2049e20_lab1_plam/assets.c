@@ -0,0 +1,73 @@
+/** assets.c
+ *
+ * Generated by tools/compile_assets.c from the files listed in assets.h.
+ * Do not edit; rerun the tool instead.
+ */
+
+#include "assets.h"
+
+//assets/ti_logo.pbm, 69x64, 576 bytes unpacked
+#pragma DATA_SECTION(asset_ti_logo, ".assets")
+static const uint8_t asset_ti_logo[488] = {
+    0x04,0x00,0x00,0x3F,0xFF,0x80,0x84,0x00,0x02,0x3F,0xFF,0xC0,0x84,0x00,0x02,0x3F,
+    0xFF,0xC0,0x84,0x00,0x02,0x3F,0xFF,0xC0,0x84,0x00,0x02,0x3F,0xFF,0xC0,0x84,0x00,
+    0x02,0x3F,0xFF,0xC0,0x84,0x00,0x02,0x3F,0xFF,0xC0,0x84,0x00,0x02,0x3F,0xFF,0xC0,
+    0x84,0x00,0x03,0x3F,0xFF,0xC0,0x1E,0x83,0x00,0x03,0x3F,0xFF,0xC0,0x3F,0x83,0x00,
+    0x04,0x3F,0xFF,0xC0,0x3F,0x80,0x82,0x00,0x04,0x3F,0xFF,0xC0,0x3F,0x80,0x82,0x00,
+    0x03,0x3F,0xFF,0xC0,0x3F,0x83,0x00,0x03,0x3F,0xFF,0xE0,0x1E,0x83,0x00,0x05,0x3F,
+    0xFF,0xFC,0x00,0x0F,0xFF,0x81,0x00,0x60,0x3F,0xFF,0xFC,0x00,0x0F,0xFF,0x80,0x00,
+    0x00,0x3F,0xFF,0xFC,0x7F,0x1F,0xFF,0x80,0x00,0x00,0x3F,0xFF,0xFC,0x7F,0x1F,0xFF,
+    0x80,0x00,0x00,0x3F,0xFF,0xF8,0x7F,0x1F,0xFF,0x80,0x00,0x00,0x3F,0xFF,0xF8,0xFF,
+    0x1F,0xFF,0x80,0x00,0x00,0x3F,0xFE,0x00,0xFF,0x00,0xFF,0x80,0x00,0x00,0x3F,0xFE,
+    0x00,0xFE,0x00,0xFF,0x80,0x00,0x00,0x3F,0xFE,0x00,0xFE,0x00,0xFF,0x80,0x00,0x00,
+    0x3F,0xFC,0x00,0xFE,0x00,0xFF,0x80,0x00,0x00,0x3F,0xFC,0x01,0xFE,0x00,0xFF,0x80,
+    0x00,0x00,0x3F,0xFC,0x01,0xFC,0x01,0xFF,0xC0,0x81,0xFF,0x05,0xFC,0x01,0xFC,0x01,
+    0xFF,0xC0,0x82,0xFF,0x04,0xE1,0xFC,0x7F,0xFF,0xE0,0x82,0xFF,0x05,0xE3,0xFC,0x7F,
+    0xFF,0xF0,0x7F,0x81,0xFF,0x05,0xE3,0xFC,0x7F,0xFF,0xF8,0x3F,0x81,0xFF,0x05,0xE3,
+    0xF8,0xFF,0xFF,0xF8,0x0F,0x81,0xFF,0x05,0xE3,0xF8,0xFF,0xFF,0xF8,0x07,0x81,0xFF,
+    0x05,0xC3,0xF8,0xFF,0xFF,0xF8,0x03,0x81,0xFF,0x05,0xC7,0xF8,0xFF,0xFF,0xF8,0x01,
+    0x81,0xFF,0x05,0xC7,0xF8,0xFF,0xFF,0xF8,0x00,0x81,0xFF,0x05,0xC7,0xF1,0xFF,0xFF,
+    0xF8,0x00,0x81,0xFF,0x4B,0x87,0xF1,0xFF,0xFF,0xF8,0x00,0x7F,0xFF,0xFF,0x87,0xF1,
+    0xFF,0xFF,0xF0,0x00,0x7F,0xFF,0xFF,0x8F,0xF1,0xFF,0xFF,0xF0,0x00,0x7F,0xFF,0xFF,
+    0x8F,0xE3,0xFF,0xFF,0xE0,0x00,0x3F,0xFF,0xFF,0x80,0x03,0xFF,0xFF,0x80,0x00,0x3F,
+    0xFF,0xFF,0x80,0x03,0xBF,0xFE,0x00,0x00,0x1F,0xF8,0x3F,0x80,0x00,0x3F,0xF8,0x00,
+    0x00,0x0F,0xF0,0x1F,0x80,0x00,0x7F,0xE0,0x00,0x00,0x07,0xC0,0x0F,0xC0,0x00,0x7F,
+    0xC0,0x82,0x00,0x03,0x07,0xC0,0x00,0x7F,0x83,0x00,0x03,0x07,0xF0,0x00,0x7E,0x83,
+    0x00,0x03,0x03,0xFC,0x03,0xFC,0x83,0x00,0x03,0x01,0xFF,0xFF,0xF8,0x83,0x00,0x03,
+    0x01,0xFF,0xFF,0xF0,0x84,0x00,0x02,0xFF,0xFF,0xE0,0x84,0x00,0x02,0xFF,0xFF,0xE0,
+    0x84,0x00,0x02,0x7F,0xFF,0xC0,0x84,0x00,0x02,0x7F,0xFF,0xC0,0x84,0x00,0x02,0x3F,
+    0xFF,0xC0,0x84,0x00,0x02,0x3F,0xFF,0x80,0x84,0x00,0x02,0x1F,0xFF,0x80,0x84,0x00,
+    0x02,0x1F,0xFF,0x80,0x84,0x00,0x02,0x0F,0xFF,0xC0,0x84,0x00,0x02,0x07,0xFF,0xC0,
+    0x84,0x00,0x02,0x03,0xFF,0xC0,0x84,0x00,0x02,0x01,0xFF,0xE0,0x85,0x00,0x01,0x7F,
+    0xE0,0x85,0x00,0x03,0x1F,0xC0,0x00,0x00
+};
+
+//assets/lp_rocket.pbm, 96x37, 444 bytes unpacked
+#pragma DATA_SECTION(asset_lp_rocket, ".assets")
+static const uint8_t asset_lp_rocket[306] = {
+    0xA0,0x00,0x01,0xFF,0x80,0x87,0x00,0x02,0x3F,0xFF,0xF0,0x86,0x00,0x03,0x03,0xFE,
+    0x00,0x78,0x84,0x00,0x05,0x07,0xFC,0x1F,0xFE,0x00,0x18,0x84,0x00,0x05,0x3C,0x07,
+    0xFF,0xFF,0x00,0x08,0x84,0x00,0x05,0xE0,0x03,0xEF,0xFF,0x00,0x18,0x83,0x00,0x06,
+    0x07,0x80,0x1F,0x07,0xFF,0x80,0x38,0x83,0x00,0x06,0x07,0xF0,0x3C,0x03,0xFF,0x80,
+    0x70,0x84,0x00,0x05,0x08,0xE0,0x03,0xFF,0x80,0xE0,0x84,0x00,0x05,0x0F,0xC0,0x01,
+    0xFF,0x83,0xC0,0x84,0x00,0x04,0x07,0x00,0xE1,0xFF,0xC7,0x83,0x00,0x06,0x0F,0xF8,
+    0x04,0x03,0xE1,0xFF,0xDC,0x82,0x00,0x07,0x01,0xF8,0x00,0x04,0x1F,0xE1,0xFF,0xF8,
+    0x82,0x00,0x07,0x0F,0x00,0x01,0xE3,0xFE,0x01,0xFF,0xC0,0x82,0x00,0x06,0x78,0x00,
+    0x7F,0x87,0xE0,0x01,0xFF,0x82,0x00,0x07,0x01,0xC0,0x0F,0xC0,0x7F,0x00,0x01,0xFC,
+    0x82,0x00,0x07,0x07,0x00,0x78,0x01,0xF3,0x00,0x0F,0xE0,0x82,0x00,0x06,0x18,0x03,
+    0x80,0x00,0x01,0x07,0xFE,0x83,0x00,0x06,0x60,0x1C,0x00,0x00,0x01,0xFF,0xF0,0x82,
+    0x00,0x07,0x01,0x80,0x70,0x00,0x06,0x01,0xE0,0x20,0x82,0x00,0x07,0x07,0x01,0x80,
+    0x00,0x18,0x30,0x80,0x40,0x82,0x00,0x07,0x1C,0x06,0x00,0x00,0x70,0x60,0x80,0x80,
+    0x82,0x00,0x06,0x30,0x18,0x00,0x01,0xC0,0xC1,0x03,0x83,0x00,0x06,0xE0,0x60,0x00,
+    0x07,0x03,0x03,0x0E,0x82,0x00,0x07,0x01,0x81,0xC0,0x00,0x38,0x0E,0x0C,0xF0,0x82,
+    0x00,0x07,0x03,0x01,0x00,0x07,0xC0,0x18,0x3F,0x80,0x82,0x00,0x06,0x06,0x00,0x00,
+    0x7E,0x00,0x60,0x30,0x83,0x00,0x05,0x08,0x00,0x00,0x40,0x01,0xC0,0x84,0x00,0x04,
+    0x10,0x00,0x60,0x00,0x07,0x85,0x00,0x04,0x3F,0xFF,0xC0,0x00,0x38,0x86,0x00,0x03,
+    0x01,0x80,0x03,0xC0,0x86,0x00,0x02,0x01,0x01,0xFE,0x87,0x00,0x02,0x03,0xFF,0x80,
+    0x9E,0x00
+};
+
+const GfxAsset g_assets[NUM_ASSETS] = {
+    {69, 64, 488, asset_ti_logo},
+    {96, 37, 306, asset_lp_rocket},
+};
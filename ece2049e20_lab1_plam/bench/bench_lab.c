@@ -0,0 +1,65 @@
+/** bench_lab.c
+ *
+ *  Created on: Oct 19, 2026
+ *
+ * Host benchmark suite for Blackjack: the shared graphics workloads, the
+ * deck and hand logic of deal.c and the card sprites of cards.c. Run from
+ * the lab directory:
+ *
+ *   gcc -std=gnu99 -O2 -DPROFILE_ENABLE -D__MSP430F5529 -Itools -I. -Igrlib \
+ *       -o bench_host bench/bench_lab.c bench/bench_host.c tools/lcd_host.c \
+ *       LcdDriver/sharp128/Sharp128x128.c gfx.c fonts/fontfixed6x8.c \
+ *       utils/profile.c deal.c cards.c
+ *   ./bench_host bench/baseline.json
+ *
+ * See bench_host.h for the output and the regression check.
+ */
+
+#ifndef __MSP430__
+
+#include <stdlib.h>
+#include "strucs.h"
+#include "deal.h"
+#include "cards.h"
+#include "bench_host.h"
+
+int main(int argc, char **argv)
+{
+    static Card deck[DECK_SIZE];
+    static Player hands[8];
+    int seed = 0;
+    int n = 0;
+    int i, j;
+
+    benchHostBegin(argc, argv);
+
+    //Random hands of MAX_CARDS values (aces counted as 11), built up front
+    //so only evalHand is timed
+    srand(1);
+    for (i = 0; i < 8; i++) {
+        hands[i].turn = TRUE;
+        for (j = 0; j < MAX_CARDS; j++) {
+            hands[i].hand[j] = (rand() % 10) + 2;
+        }
+    }
+
+    while (benchHostPass()) {
+        benchHostGraphics();
+
+        BENCH_HOST("deck_populate_shuffle",
+                   populateDeck(deck); shuffle(deck, seed++));
+        BENCH_HOST("eval_hand",
+                   evalHand(&hands[n++ & 7]));
+
+        //A card from its cached sprite, then every card of the shuffled
+        //deck in turn so each draw composites its sprite first
+        BENCH_HOST("draw_card",
+                   cardDraw('S', 'A', 35, 35));
+        BENCH_HOST("draw_card_cold",
+                   cardDraw(deck[n % DECK_SIZE].suit, deck[n % DECK_SIZE].face, 35, 35); n++);
+    }
+
+    return benchHostEnd();
+}
+
+#endif /* __MSP430__ */
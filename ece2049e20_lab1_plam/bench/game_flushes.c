@@ -0,0 +1,203 @@
+/** game_flushes.c
+ *
+ *  Created on: Oct 19, 2026
+ *
+ * Plays one match of the game on the host and counts, for every state, the
+ * flushes it asks for and the Sharp128x128 flushes that reach the bus. The
+ * real game.c, deal.c, card, label and screen code, graphics core and
+ * Sharp128x128 driver run with tools/lcd_host.c in place of the display
+ * HAL. Run from the lab directory:
+ *
+ *   gcc -std=gnu99 -O2 -D__MSP430F5529 -Itools -I. -Igrlib \
+ *       -o game_flushes bench/game_flushes.c tools/lcd_host.c \
+ *       LcdDriver/sharp128/Sharp128x128.c gfx.c fonts/fontfixed6x8.c \
+ *       game.c deal.c cards.c assets.c labels.c screens.c screen_images.c \
+ *       utils/fmt.c
+ *   ./game_flushes
+ *
+ * Each pass of the loop below is one pass of main()'s loop and stands for
+ * one timebase tick. The player answers every prompt PLAYER_WAIT_TICKS
+ * after it comes up: any button on the title, left twice then right at the
+ * cut, half at the bet, one hit and then stay at the table, and continue
+ * after each round. Requests are served at the end of the pass that made
+ * them, as displayService() does, so several in one pass cost one flush.
+ * A request counts against the state the game is in when it is made.
+ */
+
+#ifndef __MSP430__
+
+#include <stdio.h>
+#include "peripherals.h"
+#include "main.h"
+#include "strucs.h"
+#include "game.h"
+#include "lcd_host.h"
+
+#define PLAYER_WAIT_TICKS   100     //0.5 s to answer a prompt
+#define SWDELAY_TICKS       100     //swDelay(1) is about half a second
+#define MAX_TICKS           100000UL
+
+typedef struct {
+    unsigned long ticks;        //Time spent in the state, swDelay() included
+    unsigned int requested;     //gameFlush() calls
+    unsigned int flushes;       //Sharp128x128 flushes
+    unsigned long bytes;        //Bytes those flushes sent
+} StateFlushes;
+
+static const char * const stateNames[NUM_STATES] = {
+    "START", "CUT", "GAMBLE", "DEAL", "PLAYER_BET", "CPU_BET",
+    "WIN", "LOSE", "DRAW", "RESET", "TOTAL_RESET"
+};
+
+volatile unsigned char P1OUT;
+volatile unsigned char P4OUT;
+tContext g_sContext;
+
+static Game game;
+static StateFlushes counts[NUM_STATES];
+static unsigned long tick;
+static int pending = -1; //State that asked for a flush, -1 if none
+
+//The frame governor and the timer the game reads
+void displayInvalidate(void)
+{
+    pending = game.state;
+    counts[pending].requested++;
+}
+
+/*
+ * Flushes if a flush was asked for, counted against the state that asked.
+ * A flush with no changed rows calls the driver but sends nothing.
+ */
+void displayService(void)
+{
+    uint32_t sent = g_lcdBusFlushes;
+
+    if (pending < 0) {
+        return;
+    }
+    Graphics_flushBuffer(&g_sContext);
+    counts[pending].flushes++;
+    if (g_lcdBusFlushes != sent) {
+        counts[pending].bytes += g_lcdBusFlush.bytes;
+    }
+    pending = -1;
+}
+
+unsigned long timebaseNow(void)
+{
+    return tick;
+}
+
+void swDelay(char numLoops)
+{
+    displayService();
+    tick += numLoops * SWDELAY_TICKS;
+}
+
+void resetLaunchpadLeds(void)
+{
+    P1OUT = 0;
+    P4OUT = 0;
+}
+
+/*
+ * The button the player presses since ticks after state came up, or 0.
+ * hits counts the hits taken this round.
+ */
+static char playerPress(gameStates state, unsigned long since, int hits)
+{
+    int press = (int)(since / PLAYER_WAIT_TICKS) - 1; //Prompts answered so far
+
+    if (((since % PLAYER_WAIT_TICKS) != 0) || (press < 0)) {
+        return 0;
+    }
+
+    switch (state) {
+    case START:
+        return (press == 0) ? BUTTON_RIGHT : 0;
+    case CUT:
+        return (press < 2) ? BUTTON_LEFT : (press == 2) ? BUTTON_RIGHT : 0;
+    case GAMBLE:
+        return (press == 0) ? BUTTON_LEFT : 0;
+    case PLAYER_BET:
+        return (press == 0) ? ((hits == 0) ? BUTTON_RIGHT : BUTTON_LEFT) : 0;
+    case WIN:
+    case LOSE:
+    case DRAW:
+        return (press == 0) ? BUTTON_RIGHT : 0;
+    default:
+        return 0;
+    }
+}
+
+int main(void)
+{
+    static const DebounceEvents none;
+    DebounceEvents events;
+    gameStates last;
+    unsigned long before;
+    unsigned long since = 0;
+    int hits = 0;
+    int started = 0;
+    int i;
+    StateFlushes total = {0, 0, 0, 0};
+
+    //Same context as configDisplay()
+    Graphics_initContext(&g_sContext, &g_sharp128x128LCD);
+    Graphics_setForegroundColor(&g_sContext, ClrBlack);
+    Graphics_setBackgroundColor(&g_sContext, ClrWhite);
+    Graphics_setFont(&g_sContext, &g_sFontFixed6x8);
+    Graphics_clearDisplay(&g_sContext);
+    lcdHostReset();
+
+    gameInit(&game);
+    displayService();
+
+    //One match: until the game is back on the title screen
+    while (tick < MAX_TICKS) {
+        last = game.state;
+        before = tick;
+        events = none;
+        events.pressed = playerPress(game.state, since, hits);
+        gameStep(&game, &events);
+        displayService();
+        tick++;
+        counts[last].ticks += tick - before;
+
+        if ((last == PLAYER_BET) && (events.pressed & BUTTON_RIGHT)) {
+            hits++;
+        }
+        if (game.state != last) {
+            since = 0;
+            if (game.state == DEAL) {
+                hits = 0;
+            }
+            if (game.state == START) {
+                break;
+            }
+            started = 1;
+        } else {
+            since++;
+        }
+    }
+    if (!started || tick >= MAX_TICKS) {
+        fprintf(stderr, "game_flushes: the match did not finish\n");
+        return 1;
+    }
+
+    printf("state         ticks  requested  flushes     bytes\n");
+    for (i = 0; i < NUM_STATES; i++) {
+        printf("%-11s %7lu  %9u  %7u  %8lu\n", stateNames[i], counts[i].ticks,
+               counts[i].requested, counts[i].flushes, counts[i].bytes);
+        total.ticks += counts[i].ticks;
+        total.requested += counts[i].requested;
+        total.flushes += counts[i].flushes;
+        total.bytes += counts[i].bytes;
+    }
+    printf("%-11s %7lu  %9u  %7u  %8lu\n", "total", total.ticks,
+           total.requested, total.flushes, total.bytes);
+    return 0;
+}
+
+#endif /* __MSP430__ */
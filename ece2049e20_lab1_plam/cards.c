@@ -0,0 +1,131 @@
+/** cards.c
+ *
+ *  Created on: Oct 19, 2026
+ *
+ * Card sprites. See cards.h.
+ *
+ * Glyphs are 7 rows, most significant bit leftmost. The sprite cache is
+ * direct mapped on the card number (suit * NFACES + face), so a card always
+ * lands in the same slot and a lookup is one compare.
+ */
+
+#include <string.h>
+#include "main.h"
+#include "cards.h"
+#include "utils/profile.h"
+
+#define GLYPH_ROWS  7
+#define RANK_X      3   //Left edge of the rank glyph in the sprite
+#define SUIT_X      14  //Left edge of the suit glyph
+
+static const char suitOrder[NSUITS + 1] = "HDCS";
+static const char faceOrder[NFACES + 1] = "A23456789XJQK";
+
+#ifdef GFX_CORE
+static const uint8_t suitGlyphs[NSUITS][GLYPH_ROWS] = {
+    {0x6C, 0x92, 0x82, 0x82, 0x44, 0x28, 0x10}, //Heart, hollow
+    {0x10, 0x28, 0x44, 0x82, 0x44, 0x28, 0x10}, //Diamond, hollow
+    {0x38, 0x38, 0xD6, 0xFE, 0xD6, 0x10, 0x38}, //Club
+    {0x10, 0x38, 0x7C, 0xFE, 0xD6, 0x10, 0x38}  //Spade
+};
+
+static const uint8_t rankGlyphs[NFACES][GLYPH_ROWS] = {
+    {0x70, 0x88, 0x88, 0xF8, 0x88, 0x88, 0x88}, //A
+    {0x70, 0x88, 0x08, 0x10, 0x20, 0x40, 0xF8}, //2
+    {0xF8, 0x10, 0x20, 0x10, 0x08, 0x88, 0x70}, //3
+    {0x10, 0x30, 0x50, 0x90, 0xF8, 0x10, 0x10}, //4
+    {0xF8, 0x80, 0xF0, 0x08, 0x08, 0x88, 0x70}, //5
+    {0x30, 0x40, 0x80, 0xF0, 0x88, 0x88, 0x70}, //6
+    {0xF8, 0x08, 0x10, 0x20, 0x40, 0x40, 0x40}, //7
+    {0x70, 0x88, 0x88, 0x70, 0x88, 0x88, 0x70}, //8
+    {0x70, 0x88, 0x88, 0x78, 0x08, 0x10, 0x60}, //9
+    {0x4C, 0xD2, 0x52, 0x52, 0x52, 0x52, 0xEC}, //10, 7 pixels wide
+    {0x38, 0x10, 0x10, 0x10, 0x10, 0x90, 0x60}, //J
+    {0x70, 0x88, 0x88, 0x88, 0xA8, 0x90, 0x68}, //Q
+    {0x88, 0x90, 0xA0, 0xC0, 0xA0, 0x90, 0x88}  //K
+};
+
+//Card outline; the corner pixels are left showing the table
+static const uint8_t cardMask[CARD_HEIGHT][CARD_STRIDE] = {
+    {0x7F, 0xFF, 0xFE},
+    {0xFF, 0xFF, 0xFF}, {0xFF, 0xFF, 0xFF}, {0xFF, 0xFF, 0xFF}, {0xFF, 0xFF, 0xFF},
+    {0xFF, 0xFF, 0xFF}, {0xFF, 0xFF, 0xFF}, {0xFF, 0xFF, 0xFF},
+    {0x7F, 0xFF, 0xFE}
+};
+
+static uint8_t cache[CARD_CACHE_SLOTS][CARD_HEIGHT][CARD_STRIDE];
+static uint8_t cacheCard[CARD_CACHE_SLOTS]; //Card number + 1 held by each slot, 0 if empty
+
+
+/**
+ * ORs an 8 pixel wide glyph row into a sprite row at pixel x
+ */
+static void putGlyphRow(uint8_t* row, int x, uint8_t bits) {
+    row[x >> 3] |= bits >> (x & 0x7);
+    if (x & 0x7) {
+        row[(x >> 3) + 1] |= bits << (8 - (x & 0x7));
+    }
+}
+
+
+/**
+ * Returns the sprite of card number card, compositing it into its cache
+ * slot first if the slot holds another card
+ */
+static const uint8_t* cardSprite(int card) {
+    int slot = card % CARD_CACHE_SLOTS;
+    uint8_t (*sprite)[CARD_STRIDE] = cache[slot];
+    const uint8_t* rank = rankGlyphs[card % NFACES];
+    const uint8_t* suit = suitGlyphs[card / NFACES];
+    int r;
+
+    if (cacheCard[slot] != card + 1) {
+        memset(sprite, 0, sizeof(cache[slot]));
+        putGlyphRow(sprite[0], 1, 0xFF); //Top edge between the corners
+        putGlyphRow(sprite[0], 9, 0xFF);
+        putGlyphRow(sprite[0], 15, 0xFF);
+        memcpy(sprite[CARD_HEIGHT - 1], sprite[0], CARD_STRIDE); //Bottom edge
+        for (r = 0; r < GLYPH_ROWS; r++) {
+            sprite[r + 1][0] = 0x80; //Left edge
+            sprite[r + 1][CARD_STRIDE - 1] = 0x01; //Right edge
+            putGlyphRow(sprite[r + 1], RANK_X, rank[r]);
+            putGlyphRow(sprite[r + 1], SUIT_X, suit[r]);
+        }
+        cacheCard[slot] = card + 1;
+    }
+    return &sprite[0][0];
+}
+#endif /* GFX_CORE */
+
+
+/**
+ * Draws the card given by its suit and face letters centered near x, y.
+ * Without the graphics core the card is drawn as text, e.g. "S-A".
+ */
+void cardDraw(char suit, char face, int x, int y) {
+#ifdef GFX_CORE
+    const char* s = strchr(suitOrder, suit);
+    const char* f = strchr(faceOrder, face);
+
+    if (!suit || !face || !s || !f) { //strchr also finds the terminator
+        return;
+    }
+
+    PROFILE_BEGIN(PROF_DRAW_CARD);
+    gfxDrawSprite(&g_sContext, cardSprite((s - suitOrder) * NFACES + (f - faceOrder)),
+                  &cardMask[0][0], CARD_STRIDE, CARD_HEIGHT,
+                  (x - CARD_WIDTH / 2 + 4) & ~0x7, y - CARD_HEIGHT / 2);
+    PROFILE_END(PROF_DRAW_CARD);
+#else
+    unsigned char str[4];
+
+    str[0] = suit;
+    str[1] = '-';
+    str[2] = face;
+    str[3] = '\0';
+
+    PROFILE_BEGIN(PROF_DRAW_CARD);
+    Graphics_drawStringCentered(&g_sContext, str, AUTO_STRING_LENGTH, x, y, TRANSPARENT_TEXT);
+    PROFILE_END(PROF_DRAW_CARD);
+#endif
+}
@@ -0,0 +1,28 @@
+/** cards.h
+ *
+ *  Created on: Oct 19, 2026
+ *
+ * Card graphics. A card is a CARD_WIDTH x CARD_HEIGHT sprite: a frame with
+ * rounded corners, the rank on the left and the suit on the right (hearts
+ * and diamonds hollow, clubs and spades filled). Sprites are composited
+ * from rank and suit glyphs the first time a card is drawn and kept in a
+ * small cache, so drawing a card again is a masked blit of a few bytes per
+ * row.
+ *
+ * Cards are snapped to the byte column nearest to the x they are centered
+ * on, so the blit never shifts.
+ */
+
+#ifndef CARDS_H_
+#define CARDS_H_
+
+#include "peripherals.h"
+
+#define CARD_WIDTH          24
+#define CARD_HEIGHT         9   //Fits the 10 row pitch of a hand
+#define CARD_STRIDE         (CARD_WIDTH / 8)
+#define CARD_CACHE_SLOTS    8   //Sprites kept, CARD_HEIGHT * CARD_STRIDE bytes each
+
+void cardDraw(char suit, char face, int x, int y);
+
+#endif
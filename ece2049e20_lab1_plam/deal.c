@@ -9,6 +9,8 @@
 #include "main.h"
 #include "strucs.h"
 #include "deal.h"
+#include "cards.h"
+#include "utils/profile.h"
 
 
 extern char suits[NSUITS] = {'H', 'D', 'C', 'S'};
@@ -98,6 +100,8 @@ int evalHand(Player* player) { //to determine total value of hand and if any ace
     int i;
     int total = 0;
     int numAce = 0; //Counts number of aces present in hand
+
+    PROFILE_BEGIN(PROF_EVAL_HAND);
     for (i = 0; i < MAX_CARDS; i++) {
         if (player[0].turn == TRUE){
             if (player[0].hand[i] == 11) {
@@ -115,6 +119,7 @@ int evalHand(Player* player) { //to determine total value of hand and if any ace
             numAce--;
         }
    }
+   PROFILE_END(PROF_EVAL_HAND);
    return total;
 }
 
@@ -140,16 +145,10 @@ void dealHand(Player* player, Card* deck, Counter* counter) {
 
 
 /**
- * Creates a buffer to display a string on the LCD
+ * Draws a card on the LCD as a sprite, see cards.h
  */
 void displayCard(char suit, char face, int x, int y) {
-  unsigned char str[4];
-      str[0] = suit;
-      str[1] = '-';
-      str[2] = face;
-      str[3] = '\0';
-
-  Graphics_drawStringCentered(&g_sContext, str, AUTO_STRING_LENGTH, x, y, TRANSPARENT_TEXT);
+    cardDraw(suit, face, x, y);
 }
 
 
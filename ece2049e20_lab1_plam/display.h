@@ -0,0 +1,41 @@
+/** display.h
+ *
+ *  Created on: Oct 19, 2026
+ *
+ * Frame governor for the LCD. Code that draws calls displayInvalidate()
+ * instead of Graphics_flushBuffer(); the frame buffer is then sent at most
+ * once per frame period by displayService(), which the main loop and
+ * swDelay() call. Any number of invalidates inside one period cost a single
+ * SPI frame. displayPresent() is for screens that are followed by blocking
+ * code: it waits for the next frame boundary and flushes before returning.
+ *
+ * Timer A1 provides the frame boundary and also paces the VCOM toggle.
+ * displayDumpUart() reports flushes requested against flushes performed
+ * (PROFILE_ENABLE only).
+ */
+
+#ifndef DISPLAY_H_
+#define DISPLAY_H_
+
+#include <stdint.h>
+
+#define DISPLAY_FRAME_HZ    25  // Upper bound on flushes per second
+
+// VCOM toggle rate. The panel wants VCOM inverted about once a second; a
+// toggle can wait up to one period for the next flush, so run at twice that.
+#define VCOM_TIMER_HZ       2
+
+typedef struct {
+    uint16_t requested;     // displayInvalidate() and displayPresent() calls
+    uint16_t performed;     // Flushes actually sent to the LCD
+} DisplayStats;
+
+extern DisplayStats g_displayStats;
+
+void displayInit(void);
+void displayInvalidate(void);
+void displayService(void);
+void displayPresent(void);
+void displayDumpUart(void);
+
+#endif /* DISPLAY_H_ */
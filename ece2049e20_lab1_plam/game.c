@@ -0,0 +1,450 @@
+/** game.c
+ *
+ *  Created on: Oct 19, 2026
+ *
+ * State handlers and the table that drives them. See game.h.
+ */
+
+#include <msp430.h>
+#include "peripherals.h"
+#include "main.h"
+#include "strucs.h"
+#include "deal.h"
+#include "game.h"
+#include "labels.h"
+#include "screens.h"
+#include "display.h"
+#include "timebase.h"
+#include "utils/fmt.h"
+#include "utils/profile.h"
+
+#define LAST_ROUND 3
+#define CUT_Y 55 //Row the cut number is centered on
+#define BET_SHOWN_TICKS (500 / TIMEBASE_TICK_MS) //How long the chosen bet stays up
+
+#ifdef PROFILE_ENABLE
+static const char * const stateNames[NUM_STATES] = {
+    "START", "CUT", "GAMBLE", "DEAL", "PLAYER_BET", "CPU_BET",
+    "WIN", "LOSE", "DRAW", "RESET", "TOTAL_RESET"
+};
+
+static unsigned int flushCount[NUM_STATES]; //Flushes requested in each state
+#endif
+
+
+/**
+ * Writes value as ">value<" into buf, which must hold 8 characters.
+ * Returns the length of the string.
+ */
+static int frameValue(unsigned char* buf, unsigned int value) {
+    int len;
+
+    buf[0] = '>';
+    len = fmt_u16(&buf[1], value) + 1; //Multi-digit safe, unlike value + '0'
+    buf[len++] = '<';
+    buf[len] = '\0';
+    return len;
+}
+
+/**
+ * Draws ">value<" centered at x, y
+ */
+static void drawFramedValue(unsigned int value, int x, int y, char opaque) {
+    unsigned char buffer[8];
+    int len = frameValue(buffer, value);
+
+    Graphics_drawStringCentered(&g_sContext, buffer, len, x, y, opaque);
+}
+
+/**
+ * Toggles the pixels of rect. Doing it again restores them, so a highlight
+ * is removed without redrawing what is under it.
+ */
+static void invertRect(const Graphics_Rectangle* rect) {
+    Graphics_setForegroundColor(&g_sContext, ClrInvert);
+    Graphics_fillRectangle(&g_sContext, rect);
+    Graphics_setForegroundColor(&g_sContext, ClrBlack);
+}
+
+/**
+ * Highlights a label, or removes its highlight, with a box two pixels
+ * larger than its text
+ */
+static void invertLabel(labelId id) {
+    const GfxLabel* label = &g_labels[id];
+    Graphics_Rectangle box;
+
+    box.xMin = label->x - 2;
+    box.yMin = label->y - 2;
+    box.xMax = label->x + label->length * GFX_FONT_WIDTH + 1;
+    box.yMax = label->y + GFX_FONT_HEIGHT;
+    invertRect(&box);
+}
+
+/**
+ * Toggles the pixels of the cut number. Toggling the old number and then
+ * the new one changes it without touching the highlight around it.
+ */
+static void toggleCutNum(unsigned int value) {
+    unsigned char buffer[2];
+
+    buffer[0] = '0' + value; //0-9
+    buffer[1] = '\0';
+    Graphics_setForegroundColor(&g_sContext, ClrInvert);
+    Graphics_drawStringCentered(&g_sContext, buffer, 1, H_CENTER, CUT_Y, TRANSPARENT_TEXT);
+    Graphics_setForegroundColor(&g_sContext, ClrBlack);
+}
+
+/**
+ * Moves the coins bet on a finished round to the winner. Nothing moves on a draw.
+ */
+static void settleRound(Game* game, gameStates result) {
+    Player* player = game->player;
+
+    if (result == WIN) {
+        player[0].coins += player[1].bet; //Player gains CPU bet coins
+        player[1].coins -= player[1].bet; //CPU loses coins
+    } else if (result == LOSE) {
+        player[0].coins -= player[0].bet; //Player loses bet coins
+        player[1].coins += player[0].bet; //CPU gains coins
+    }
+}
+
+
+//START: title screen, any button starts the match
+static void startEnter(Game* game) {
+    drawScreen(SCREEN_TITLE);
+    gameFlush(game);
+    resetLaunchpadLeds();
+}
+
+static gameStates startEvent(Game* game, const DebounceEvents* events) {
+    return (events->pressed != 0) ? CUT : START;
+}
+
+static void clearExit(Game* game) {
+    Graphics_clearDisplay(&g_sContext);
+}
+
+
+//CUT: left steps the cut number 0-9, repeating while held; right picks it
+static void cutEnter(Game* game) {
+    static const Graphics_Rectangle cutBox = {H_CENTER - 6, CUT_Y - 5, H_CENTER + 5, CUT_Y + 6};
+
+    drawLabel(LABEL_SELECT_CUT);
+    toggleCutNum(game->cutNum);
+    invertRect(&cutBox); //Shown white on black while it is being selected
+    gameFlush(game);
+}
+
+static gameStates cutEvent(Game* game, const DebounceEvents* events) {
+    if (events->pressed & BUTTON_RIGHT) {
+        return GAMBLE;
+    } else if (!((events->pressed | events->repeat) & BUTTON_LEFT)) {
+        return CUT;
+    }
+
+    //Only the number changes, so only its pixels are toggled
+    toggleCutNum(game->cutNum);
+    game->cutNum = (game->cutNum + 1) % 10;
+    toggleCutNum(game->cutNum);
+    gameFlush(game);
+    return CUT;
+}
+
+static void cutExit(Game* game) {
+    Graphics_clearDisplay(&g_sContext);
+    populateDeck(game->deck);
+    shuffle(game->deck, game->cutNum);
+}
+
+
+//GAMBLE: shows both coin counts, left bets half and right bets all. The
+//choice stays highlighted for BET_SHOWN_TICKS, then DEAL follows.
+static void gambleEnter(Game* game) {
+    drawLabel(LABEL_YOUR_COINS);
+    drawLabel(LABEL_CPU_COINS);
+    drawFramedValue(game->player[0].coins, 95, 35, TRANSPARENT_TEXT);
+    drawFramedValue(game->player[1].coins, 95, 45, TRANSPARENT_TEXT);
+    drawLabel(LABEL_SELECT_BET);
+    drawLabel(LABEL_ALL);
+    drawLabel(LABEL_HALF);
+    gameFlush(game);
+
+    game->player[1].bet = game->player[1].coins / 2; //CPU will always bet half their coins
+    game->betChosen = 0;
+}
+
+static gameStates gambleEvent(Game* game, const DebounceEvents* events) {
+    if (game->betChosen) {
+        //Shows the choice before the table is drawn; buttons are ignored
+        return ((long)(timebaseNow() - game->dealAt) >= 0) ? DEAL : GAMBLE;
+    }
+
+    if (events->pressed & BUTTON_RIGHT) {
+        game->player[0].bet = game->player[0].coins; //Player bets all their coins
+        invertLabel(LABEL_ALL);
+    } else if (events->pressed & BUTTON_LEFT) {
+        game->player[0].bet = game->player[0].coins / 2; //Player bets half their coins
+        invertLabel(LABEL_HALF);
+    } else {
+        return GAMBLE;
+    }
+
+    gameFlush(game);
+    game->betChosen = 1;
+    game->dealAt = timebaseNow() + BET_SHOWN_TICKS;
+    return GAMBLE;
+}
+
+
+//DEAL: draws the table and deals two cards to the player and one to the CPU
+static void dealEnter(Game* game) {
+    drawScreen(SCREEN_TABLE);
+    drawFramedValue(game->numRounds, 65, 10, TRANSPARENT_TEXT);
+
+    initHand(game->player, game->deck, &game->counter); //Initialize player and CPU hands
+    gameFlush(game);
+}
+
+static gameStates dealEvent(Game* game, const DebounceEvents* events) {
+    return PLAYER_BET;
+}
+
+
+//PLAYER_BET: right hits, left stays
+static void playerBetEnter(Game* game) {
+    resetLaunchpadLeds();
+    game->player[0].turn = TRUE; //It is the player's turn
+    P4OUT |= BIT7; //Enable right button as turn indicator
+}
+
+static gameStates playerBetEvent(Game* game, const DebounceEvents* events) {
+    Player* player = game->player;
+    Counter* counter = &game->counter;
+
+    if (events->pressed & BUTTON_RIGHT) {
+        if (counter->yp > 95) { //Reset display if too many cards on the screen
+            drawScreen(SCREEN_TABLE_CONT);
+            counter->yp = 35, counter->yc = 35; //Reset counters for y parameter for displaying cards
+        }
+
+        dealHand(player, game->deck, counter); //Deal card and read value of hand
+        player[0].sum = evalHand(player);
+
+        gameFlush(game);
+
+        return (player[0].sum <= BUST) ? CPU_BET : LOSE;
+    } else if (events->pressed & BUTTON_LEFT) { //Player decides to stay
+        player[0].sum = evalHand(player);
+        return CPU_BET;
+    }
+    return PLAYER_BET;
+}
+
+
+//CPU_BET: CPU hits below 17, otherwise the hands are compared
+static void cpuBetEnter(Game* game) {
+    resetLaunchpadLeds();
+}
+
+static gameStates cpuBetEvent(Game* game, const DebounceEvents* events) {
+    Player* player = game->player;
+
+    if (player[1].sum < CPU_MAX) { //If CPU hand is less than 17
+        player[0].turn = FALSE; //It is the CPU's turn
+        P1OUT |= BIT0; //Enable left LED as turn indicator
+
+        dealHand(player, game->deck, &game->counter);
+        player[1].sum = evalHand(player);
+
+        gameFlush(game);
+        swDelay(1);
+
+        return (player[1].sum <= BUST) ? PLAYER_BET : WIN;
+    }
+
+    if (player[1].sum < player[0].sum) { //Player wins if hand is greater than CPU
+        return WIN;
+    } else if (player[1].sum == player[0].sum) { //Draws if hands are equal
+        return DRAW;
+    }
+    return LOSE; //Player loses if hand is less than CPU
+}
+
+
+//WIN, LOSE, DRAW: result of the round, shared by all three states
+static void resultEnter(Game* game) {
+    Graphics_clearDisplay(&g_sContext);
+    resetLaunchpadLeds();
+
+    if (game->state == WIN) {
+        drawLabel(LABEL_WON_ROUND);
+        P4OUT |= BIT7; //Enable right LED
+    } else if (game->state == LOSE) {
+        drawLabel(LABEL_LOST_ROUND);
+        P1OUT |= BIT0; //Enable left LED
+    } else {
+        drawLabel(LABEL_DRAW_ROUND);
+        P4OUT |= BIT7; P1OUT |= BIT0; //Enable both LEDS
+    }
+
+    if (game->numRounds < LAST_ROUND) { //If three rounds haven't been played
+        drawLabel(LABEL_CONTINUE);
+        drawLabel(LABEL_YES);
+        drawLabel(LABEL_NO);
+    }
+    gameFlush(game);
+}
+
+static gameStates resultEvent(Game* game, const DebounceEvents* events) {
+    if (game->numRounds >= LAST_ROUND) { //Match is over, show the result briefly
+        swDelay(1);
+        return TOTAL_RESET;
+    }
+
+    if (events->pressed & BUTTON_RIGHT) { //If player wants to continue the match
+        game->numRounds++; //Next round
+        return RESET;
+    } else if (events->pressed & BUTTON_LEFT) { //If player discontinues the match
+        return TOTAL_RESET;
+    }
+    return game->state;
+}
+
+static void resultExit(Game* game) {
+    settleRound(game, game->state);
+    Graphics_clearDisplay(&g_sContext);
+}
+
+
+//RESET: "continue" was selected and 3 rounds have not been played
+static void resetEnter(Game* game) {
+    resetLaunchpadLeds();
+    resetHands(game->player, &game->counter);
+    game->player[1].sum = 0;
+}
+
+static gameStates resetEvent(Game* game, const DebounceEvents* events) {
+    return CUT;
+}
+
+
+//TOTAL_RESET: shows the match result and resets player stats
+static void totalResetEnter(Game* game) {
+    Player* player = game->player;
+
+    resetLaunchpadLeds();
+
+    if (player[0].coins > player[1].coins) { //If player has more coins
+        P4OUT |= BIT7; //Enable left LED
+        drawLabel(LABEL_YOU_WON);
+    } else if (player[0].coins < player[1].coins) { //If CPU has more coins
+        P1OUT |= BIT0; //Enable right LED
+        drawLabel(LABEL_YOU_LOST);
+    } else { //Draw
+        P4OUT |= BIT7; P1OUT |= BIT0; //Turn both LEDs on
+        drawLabel(LABEL_DRAW_MATCH);
+    }
+
+    gameFlush(game);
+    profileDumpUart(); //Report timing for the finished match (PROFILE_ENABLE only)
+    gameDumpFlushCounts();
+}
+
+static gameStates totalResetEvent(Game* game, const DebounceEvents* events) {
+    swDelay(1);
+    return START;
+}
+
+static void totalResetExit(Game* game) {
+    fullReset(game->player, &game->counter);
+    game->numRounds = 1;
+    Graphics_clearDisplay(&g_sContext);
+}
+
+
+//Indexed by gameStates
+static const StateHandlers stateTable[NUM_STATES] = {
+    {startEnter,        startEvent,         clearExit},         //START
+    {cutEnter,          cutEvent,           cutExit},           //CUT
+    {gambleEnter,       gambleEvent,        clearExit},         //GAMBLE
+    {dealEnter,         dealEvent,          NULL},              //DEAL
+    {playerBetEnter,    playerBetEvent,     NULL},              //PLAYER_BET
+    {cpuBetEnter,       cpuBetEvent,        NULL},              //CPU_BET
+    {resultEnter,       resultEvent,        resultExit},        //WIN
+    {resultEnter,       resultEvent,        resultExit},        //LOSE
+    {resultEnter,       resultEvent,        resultExit},        //DRAW
+    {resetEnter,        resetEvent,         NULL},              //RESET
+    {totalResetEnter,   totalResetEvent,    totalResetExit},    //TOTAL_RESET
+};
+
+
+/**
+ * Puts the game in its power-up state and draws the title screen
+ */
+void gameInit(Game* game) {
+    game->cutNum = 0;
+    game->numRounds = 1;
+    fullReset(game->player, &game->counter);
+    game->state = START;
+    stateTable[START].onEnter(game);
+}
+
+/**
+ * Passes the button events to the current state and runs the exit and
+ * enter handlers if it asks for a different state
+ */
+void gameStep(Game* game, const DebounceEvents* events) {
+    gameStates next = stateTable[game->state].onEvent(game, events);
+
+    if (next != game->state) {
+        if (stateTable[game->state].onExit != NULL) {
+            stateTable[game->state].onExit(game);
+        }
+        game->state = next;
+        if (stateTable[next].onEnter != NULL) {
+            stateTable[next].onEnter(game);
+        }
+    }
+}
+
+/**
+ * Marks the frame buffer for the next frame, counting the request against the
+ * current state. The flush itself happens in displayService().
+ */
+void gameFlush(Game* game) {
+#ifdef PROFILE_ENABLE
+    flushCount[game->state]++;
+#endif
+    displayInvalidate();
+}
+
+/**
+ * Writes the flushes requested in each state and the flushes the display
+ * actually performed to the UART, then clears them (PROFILE_ENABLE only)
+ */
+void gameDumpFlushCounts(void) {
+#ifdef PROFILE_ENABLE
+    char line[24];
+    int i, len;
+
+    profileUartPuts("state     requested\r\n");
+    for (i = 0; i < NUM_STATES; i++) {
+        const char* name = stateNames[i];
+
+        len = 0;
+        while (*name) {
+            line[len++] = *name++;
+        }
+        while (len < 12) {
+            line[len++] = ' ';
+        }
+        profileFormatU32(&line[len], flushCount[i], 7);
+        profileUartPuts(line);
+        profileUartPuts("\r\n");
+        flushCount[i] = 0;
+    }
+    displayDumpUart(); //Requests in the same frame period share one flush
+#endif
+}
@@ -0,0 +1,32 @@
+/** game.h
+ *
+ *  Created on: Oct 19, 2026
+ *
+ * Table-driven state machine for the Blackjack game. Each state has an
+ * on-enter handler that draws its screen and flushes once, an on-event
+ * handler that is polled with the button events taken since the last poll
+ * and returns the next state, and an optional on-exit handler. Handlers act
+ * on presses; only CUT also steps on the repeats of a held button. Enter and exit run only on transitions,
+ * so a state waiting for input does not touch the display.
+ */
+
+#ifndef GAME_H_
+#define GAME_H_
+
+#include "main.h"
+#include "strucs.h"
+#include "debounce.h"
+
+typedef struct stateHandlers
+{
+    void (*onEnter)(Game* game); //Draws the state's screen; may be NULL
+    gameStates (*onEvent)(Game* game, const DebounceEvents* events); //Returns the next state
+    void (*onExit)(Game* game); //May be NULL
+} StateHandlers;
+
+void gameInit(Game* game);
+void gameStep(Game* game, const DebounceEvents* events);
+void gameFlush(Game* game);
+void gameDumpFlushCounts(void);
+
+#endif
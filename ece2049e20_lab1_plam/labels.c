@@ -0,0 +1,17 @@
+/** labels.c
+ *
+ *  Created on: Oct 19, 2026
+ *
+ * Label table for labels.h
+ */
+
+#include "labels.h"
+
+#define LABEL_ENTRY(id, text, x, y)     GFX_LABEL(text, x, y),
+#define LABEL_FITS(id, text, x, y)      GFX_LABEL_CHECK(id, text, x, y);
+
+const GfxLabel g_labels[NUM_LABELS] = {
+    LABELS(LABEL_ENTRY)
+};
+
+LABELS(LABEL_FITS)
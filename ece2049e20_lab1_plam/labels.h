@@ -0,0 +1,58 @@
+/** labels.h
+ *
+ *  Created on: Oct 19, 2026
+ *
+ * Constant text of the Blackjack screens. Each label is listed once in
+ * LABELS with its string and the point it is centered on; labels.c turns
+ * the list into a table laid out at compile time and checks that every
+ * label fits the panel. Draw a label with drawLabel(id). Text that changes
+ * (coin counts, cards) is still drawn with Graphics_drawStringCentered().
+ */
+
+#ifndef LABELS_H_
+#define LABELS_H_
+
+#include "peripherals.h"
+
+#define H_CENTER (LCD_HORIZONTAL_MAX/2) //X param for center of LCD screen
+
+//    id                    text                    x         y
+#define LABELS(X) \
+    X(LABEL_MSP430,         "MSP430",               H_CENTER, 45)  \
+    X(LABEL_BLACKJACK,      "Blackjack",            H_CENTER, 55)  \
+    X(LABEL_PUSH_TO_START,  "Push to Start",        H_CENTER, 75)  \
+    X(LABEL_SELECT_CUT,     "Select Cut:",          H_CENTER, 45)  \
+    X(LABEL_YOUR_COINS,     "Your coins:",          55,       35)  \
+    X(LABEL_CPU_COINS,      "CPU coins:",           55,       45)  \
+    X(LABEL_SELECT_BET,     "Select Bet:",          H_CENTER, 65)  \
+    X(LABEL_ALL,            "All",                  95,       115) \
+    X(LABEL_HALF,           "Half",                 35,       115) \
+    X(LABEL_ROUND,          "Round",                35,       10)  \
+    X(LABEL_OF_3,           "of 3",                 95,       10)  \
+    X(LABEL_TABLE_CONT,     "Table (Cont'd)",       65,       10)  \
+    X(LABEL_PLAYER,         "Player:",              35,       25)  \
+    X(LABEL_CPU,            "CPU:",                 95,       25)  \
+    X(LABEL_HIT,            "Hit",                  95,       115) \
+    X(LABEL_STAY,           "Stay",                 35,       115) \
+    X(LABEL_WON_ROUND,      "Won Round!",           H_CENTER, 45)  \
+    X(LABEL_LOST_ROUND,     "Lost Round!",          H_CENTER, 45)  \
+    X(LABEL_DRAW_ROUND,     "Draw",                 H_CENTER, 45)  \
+    X(LABEL_CONTINUE,       "Continue?",            H_CENTER, 55)  \
+    X(LABEL_YES,            "Yes",                  95,       115) \
+    X(LABEL_NO,             "No",                   35,       115) \
+    X(LABEL_YOU_WON,        "You Won!",             H_CENTER, 45)  \
+    X(LABEL_YOU_LOST,       "You Lost!",            H_CENTER, 45)  \
+    X(LABEL_DRAW_MATCH,     "Draw!",                H_CENTER, 45)
+
+#define LABEL_ID(id, text, x, y)    id,
+
+typedef enum {
+    LABELS(LABEL_ID)
+    NUM_LABELS
+} labelId;
+
+extern const GfxLabel g_labels[NUM_LABELS];
+
+#define drawLabel(id)   gfxDrawLabel(&g_sContext, &g_labels[(id)], TRANSPARENT_TEXT)
+
+#endif
@@ -148,6 +148,8 @@ SECTIONS
     .text       : {} >> FLASH2 | FLASH      /* Code                              */
 #endif
     .text:_isr  : {} > FLASH                /* ISR Code space                    */
+    .text:gfx   : {} > FLASH,               /* Graphics core (gfx.c), sized for  */
+                  SIZE(gfxTextSize)         /* the benchmark report              */
     .cinit      : {} > FLASH                /* Initialization tables             */
 #ifndef __LARGE_DATA_MODEL__
     .const      : {} > FLASH                /* Constant data                     */
@@ -155,6 +157,12 @@ SECTIONS
     .const      : {} >> FLASH | FLASH2      /* Constant data                     */
 #endif
     .cio        : {} > RAM                  /* C I/O Buffer                      */
+    .screens    : {} > FLASH2               /* Pre-rendered screens, 2 KB each   */
+    .assets     : {} > FLASH2               /* Packed 1-bpp assets (assets.h)    */
+    .lcdbuf     : {} > USBRAM               /* LCD frame buffer, uninitialized   */
+                                            /* (LCD_BUFFER_USBRAM). USBRAM holds */
+                                            /* one 128x128 frame; a second       */
+                                            /* buffer has to go in RAM.          */
 
     .pinit      : {} > FLASH                /* C++ Constructor tables            */
     .binit      : {} > FLASH                /* Boot-time Initialization tables   */
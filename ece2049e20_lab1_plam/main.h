@@ -22,20 +22,21 @@
 #define TRUE 1 //Boolean types
 #define FALSE 0
 
-typedef enum gameStates { // Declare game states
+typedef enum gameStates { // Declare game states. Order must match stateTable in game.c
     START = 0,
-    GAMBLE = 1,
-    READGAMBLE = 2,
-    CUT = 3,
-    READCUT = 4,
-    DEAL = 5,
-    PLAYER_BET = 6,
-    CPU_BET = 7,
-    WIN = 8,
-    LOSE = 9,
-    DRAW = 10,
-    RESET = 11,
-    TOTAL_RESET = 12,
+    CUT = 1,
+    GAMBLE = 2,
+    DEAL = 3,
+    PLAYER_BET = 4,
+    CPU_BET = 5,
+    WIN = 6,
+    LOSE = 7,
+    DRAW = 8,
+    RESET = 9,
+    TOTAL_RESET = 10,
+    NUM_STATES = 11
 } gameStates;
 
+void swDelay(char numLoops);
+
 #endif
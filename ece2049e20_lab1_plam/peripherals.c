@@ -13,6 +13,8 @@
  */
 
 #include "peripherals.h"
+#include "display.h"
+#include "debounce.h"
 
 
 // Globals
@@ -72,6 +74,14 @@ char readLaunchpadButtons(void)
     return (~P2IN & BIT1) | ((~P1IN & BIT1) >> 1);
 }
 
+/*
+ * Raw buttons for the debouncer: BUTTON_RIGHT and BUTTON_LEFT
+ */
+uint8_t debounceRead(void)
+{
+    return readLaunchpadButtons();
+}
+
 void initLaunchpadLeds(void)
 {
     P1SEL &= ~BIT0;
@@ -133,20 +143,8 @@ void configDisplay(void)
     Graphics_setFont(&g_sContext, &g_sFontFixed6x8);
     Graphics_clearDisplay(&g_sContext);
     Graphics_flushBuffer(&g_sContext);
-}
 
-
-//------------------------------------------------------------------------------
-// Timer1 A0 Interrupt Service Routine
-//------------------------------------------------------------------------------
-#pragma vector=TIMER1_A0_VECTOR
-__interrupt void TIMER1_A0_ISR (void)
-{
-	// Display is using Timer A1
-	// Not sure where Timer A1 is configured?
-#if defined(DISPLAY_SHARP96x96)
-	Sharp96x96_SendToggleVCOMCommand();  // display needs this toggle < 1 per sec
-#elif defined(DISPLAY_SHARP128x128)
-	Sharp128x128_SendToggleVCOMCommand();
-#endif
+    // Timer A1 paces frames and the VCOM toggle, see display.c. Needs GIE.
+    displayInit();
 }
+
@@ -30,6 +30,10 @@
 #include "LcdDriver/sharp128/HAL_MSP_EXP430F5529_Sharp128x128.h"
 #endif
 
+// In-tree graphics core; turns the Graphics_* calls below into direct calls
+// to the display driver (see gfx.h)
+#include "gfx.h"
+
 
 
 
@@ -0,0 +1,55 @@
+/** screens.c
+ *
+ *  Created on: Oct 19, 2026
+ *
+ * Labels of each screen in screens.h
+ */
+
+#include "screens.h"
+
+#define END_OF_SCREEN   NUM_LABELS
+
+static const uint8_t titleLabels[] = {
+    LABEL_MSP430, LABEL_BLACKJACK, LABEL_PUSH_TO_START, END_OF_SCREEN
+};
+
+static const uint8_t tableLabels[] = {
+    LABEL_ROUND, LABEL_OF_3, LABEL_PLAYER, LABEL_CPU, LABEL_HIT, LABEL_STAY, END_OF_SCREEN
+};
+
+static const uint8_t tableContLabels[] = {
+    LABEL_TABLE_CONT, LABEL_PLAYER, LABEL_CPU, LABEL_HIT, LABEL_STAY, END_OF_SCREEN
+};
+
+//Indexed by screenId
+static const uint8_t * const screenLabels[NUM_SCREENS] = {
+    titleLabels,
+    tableLabels,
+    tableContLabels
+};
+
+/*
+ * Replaces the frame with screen id
+ */
+void drawScreen(screenId id)
+{
+#ifdef SCREEN_IMAGES
+    gfxBlitScreen(&g_screenImages[id][0][0]);
+#else
+    screenDrawLabels(id);
+#endif
+}
+
+/*
+ * Clears the frame and draws the labels of screen id. This is what the
+ * images in screen_images.c are rendered from.
+ */
+void screenDrawLabels(screenId id)
+{
+    const uint8_t *label = screenLabels[id];
+
+    Graphics_clearDisplay(&g_sContext);
+    for (; *label != END_OF_SCREEN; label++) { //drawLabel evaluates its argument more than once
+        drawLabel(*label);
+    }
+}
@@ -0,0 +1,46 @@
+/** screens.h
+ *
+ *  Created on: Oct 19, 2026
+ *
+ * Screens whose content never changes, built from labels.h. Each one is
+ * pre-rendered on the host by tools/render_screens.c into
+ * screen_images.c, which puts the 1-bpp images in FLASH2. drawScreen()
+ * then replaces the frame with one row copy per line instead of drawing
+ * the labels. Anything that changes (round number, cards) is drawn on top
+ * afterwards.
+ *
+ * screen_images.c has to be regenerated after changing a screen, a label
+ * it uses, the font or the graphics core. Without GFX_CORE the images
+ * cannot be copied and drawScreen() draws the labels instead.
+ */
+
+#ifndef SCREENS_H_
+#define SCREENS_H_
+
+#include "peripherals.h"
+#include "labels.h"
+
+#if defined(GFX_CORE) && !defined(SCREENS_RENDER)
+#define SCREEN_IMAGES
+#endif
+
+#define SCREENS(X) \
+    X(SCREEN_TITLE)     /* Title, waits for any button */ \
+    X(SCREEN_TABLE)     /* Playing table at the start of a round */ \
+    X(SCREEN_TABLE_CONT) /* Playing table once the cards reach the bottom */
+
+#define SCREEN_ID(id)   id,
+
+typedef enum {
+    SCREENS(SCREEN_ID)
+    NUM_SCREENS
+} screenId;
+
+#ifdef SCREEN_IMAGES
+extern const uint8_t g_screenImages[NUM_SCREENS][LCD_VERTICAL_MAX][LCD_HORIZONTAL_MAX / 8];
+#endif
+
+void drawScreen(screenId id);
+void screenDrawLabels(screenId id);
+
+#endif
@@ -34,4 +34,16 @@ typedef struct counter
     unsigned int yc; //Y parameter to display CPU cards
 } Counter;
 
+typedef struct game
+{
+    gameStates state; //Current state of the engine in game.c
+    int cutNum; //Number to cut the deck
+    int numRounds; //Number of rounds played
+    Card deck[DECK_SIZE];
+    Player player[MAX_PLAYERS]; //player[0] = human player, player[1] = CPU
+    Counter counter;
+    char betChosen; //GAMBLE: the bet is picked and shown
+    unsigned long dealAt; //GAMBLE: tick to move on to DEAL once the bet is chosen
+} Game;
+
 #endif
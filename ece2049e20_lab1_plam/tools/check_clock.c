@@ -0,0 +1,90 @@
+/** check_clock.c
+ *
+ *  Created on: Oct 19, 2026
+ *
+ * Host check for the constants clock.h derives from MCLK_FREQ_HZ. The
+ * #error guards in clock.h only reject settings out of range; this pins the
+ * values themselves against a table worked out by hand from the datasheet
+ * and the TI UCS examples, so a wrong formula fails here instead of
+ * compiling silently. Build and run once per MCLK setting in the table,
+ * from the lab directory:
+ *
+ *   for f in 1000000 8000000 12000000 16000000 25000000; do
+ *       gcc -std=gnu99 -DMCLK_FREQ_HZ=${f}UL -Itools -I. -o check_clock \
+ *           tools/check_clock.c && ./check_clock || break
+ *   done
+ *
+ * Without -DMCLK_FREQ_HZ it checks the setting the firmware builds with.
+ */
+
+#ifndef __MSP430__
+
+#include <stdio.h>
+#include <msp430.h>
+#include "clock.h"
+
+typedef struct {
+    unsigned long mclk;
+    unsigned long fllN;
+    unsigned int dcoRange;
+    unsigned int pmmLevel;
+    unsigned long spiTicks;
+    unsigned long csHoldCycles;
+    unsigned long swDelayScale;
+} ClockSetting;
+
+//With SMCLK_DIV 1, LCD_SPI_FREQ_HZ 1 MHz and the 32768 Hz reference
+static const ClockSetting settings[] = {
+    { 1000000UL,  29, DCORSEL_5, 0,  1,  2,  1},
+    { 8000000UL, 243, DCORSEL_5, 0,  8, 16,  8},
+    {12000000UL, 365, DCORSEL_5, 1, 12, 24, 11},
+    {16000000UL, 487, DCORSEL_5, 2, 16, 32, 15},
+    {25000000UL, 761, DCORSEL_7, 3, 25, 50, 24},
+};
+
+static int failures = 0;
+
+static void expect(const char *name, unsigned long actual, unsigned long expected)
+{
+    if (actual != expected) {
+        fprintf(stderr, "MCLK %lu Hz: %s is %lu, expected %lu\n",
+                MCLK_FREQ_HZ, name, actual, expected);
+        failures++;
+    }
+}
+
+int main(void)
+{
+    const ClockSetting *s = 0;
+    unsigned int i;
+
+    for (i = 0; i < sizeof(settings) / sizeof(settings[0]); i++) {
+        if (settings[i].mclk == MCLK_FREQ_HZ) {
+            s = &settings[i];
+        }
+    }
+    if (!s) {
+        fprintf(stderr, "MCLK %lu Hz: no expected values in check_clock.c\n", MCLK_FREQ_HZ);
+        return 1;
+    }
+
+    expect("SMCLK_DIV", SMCLK_DIV, 1);
+    expect("SMCLK_DIVS", SMCLK_DIVS, DIVS__1);
+    expect("FLL_N", FLL_N, s->fllN);
+    expect("DCO_RANGE", DCO_RANGE, s->dcoRange);
+    expect("PMM_CORE_LEVEL", PMM_CORE_LEVEL, s->pmmLevel);
+    expect("LCD_SPI_CLK_TICKS", LCD_SPI_CLK_TICKS, s->spiTicks);
+    expect("LCD_CS_HOLD_CYCLES", LCD_CS_HOLD_CYCLES, s->csHoldCycles);
+    expect("SWDELAY_SCALE", SWDELAY_SCALE, s->swDelayScale);
+
+    //DCOCLKDIV must land within one reference period below the request
+    expect("MCLK below request", (FLL_N + 1) * FLL_REF_FREQ_HZ <= MCLK_FREQ_HZ, 1);
+    expect("MCLK within a step", MCLK_FREQ_HZ - (FLL_N + 1) * FLL_REF_FREQ_HZ < FLL_REF_FREQ_HZ, 1);
+
+    if (failures == 0) {
+        printf("MCLK %lu Hz: clock.h constants OK\n", MCLK_FREQ_HZ);
+    }
+    return failures != 0;
+}
+
+#endif /* __MSP430__ */
@@ -0,0 +1,271 @@
+/** compile_assets.c
+ *
+ *  Created on: Oct 19, 2026
+ *
+ * Host build step for assets.c. Reads every asset listed in assets.h, packs
+ * it as a PackBits stream in the format gfxDrawAsset() decodes, checks that
+ * the stream unpacks to the same rows, and writes the streams and the
+ * g_assets[] index as C. The compression ratio of every asset goes to
+ * stderr. Run from the lab directory:
+ *
+ *   gcc -std=gnu99 -Itools -I. -Igrlib -o compile_assets tools/compile_assets.c
+ *   ./compile_assets > assets.c
+ *
+ * Inputs are PBM images, P1 or P4, where 1 is ink, and BDF fonts, whose
+ * glyphs are placed in cells of the font bounding box stacked top to
+ * bottom in file order.
+ */
+
+#ifndef __MSP430__
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "assets.h"
+
+#define MAX_BYTES   0x8000 //Largest unpacked asset
+#define MAX_LINE    256
+
+typedef struct {
+    const char *name;
+    const char *file;
+    int width;
+    int height;
+    uint8_t bits[MAX_BYTES]; //Rows padded to whole bytes, MSB leftmost
+} Bitmap;
+
+#define ASSET_SOURCE(id, name, file)    { name, file },
+
+static Bitmap assets[NUM_ASSETS] = {
+    ASSETS(ASSET_SOURCE)
+};
+
+static uint8_t packed[MAX_BYTES + MAX_BYTES / 128 + 1];
+static uint8_t check[MAX_BYTES];
+
+static void fail(const Bitmap *b, const char *what)
+{
+    fprintf(stderr, "%s: %s\n", b->file, what);
+    exit(1);
+}
+
+static void setPixel(Bitmap *b, int x, int y)
+{
+    if ((x < 0) || (x >= b->width) || (y < 0) || (y >= b->height)) {
+        fail(b, "glyph outside its cell");
+    }
+    b->bits[y * ((b->width + 7) >> 3) + (x >> 3)] |= 0x80 >> (x & 0x7);
+}
+
+static void setSize(Bitmap *b, int width, int height)
+{
+    if ((width <= 0) || (height <= 0) || (((width + 7) >> 3) * height > MAX_BYTES)) {
+        fail(b, "bad size");
+    }
+    b->width = width;
+    b->height = height;
+}
+
+/*
+ * Reads the next number of a PBM header, skipping white space and comments
+ */
+static int pbmNumber(FILE *f)
+{
+    int c, n = 0;
+
+    do {
+        c = fgetc(f);
+        if (c == '#') {
+            while ((c != '\n') && (c != EOF)) {
+                c = fgetc(f);
+            }
+        }
+    } while ((c == ' ') || (c == '\t') || (c == '\r') || (c == '\n'));
+
+    while ((c >= '0') && (c <= '9')) {
+        n = n * 10 + (c - '0');
+        c = fgetc(f);
+    }
+    return n; //The white space after the number has been read
+}
+
+static void readPbm(Bitmap *b, FILE *f)
+{
+    int magic = (fgetc(f) == 'P') ? fgetc(f) : 0;
+    int width = pbmNumber(f);
+    int height = pbmNumber(f);
+    int stride, x, y, c;
+
+    if ((magic != '1') && (magic != '4')) {
+        fail(b, "not a PBM file");
+    }
+    setSize(b, width, height);
+    stride = (b->width + 7) >> 3;
+
+    if (magic == '4') {
+        if (fread(b->bits, stride, b->height, f) != (size_t)b->height) {
+            fail(b, "short P4 raster");
+        }
+        return;
+    }
+    for (y = 0; y < b->height; y++) {
+        for (x = 0; x < b->width; x++) {
+            do {
+                c = fgetc(f);
+            } while ((c != '0') && (c != '1') && (c != EOF));
+            if (c == EOF) {
+                fail(b, "short P1 raster");
+            }
+            if (c == '1') {
+                setPixel(b, x, y);
+            }
+        }
+    }
+}
+
+static void readBdf(Bitmap *b, FILE *f)
+{
+    char line[MAX_LINE];
+    int cellW = 0, cellH = 0, cellX = 0, cellY = 0;
+    int glyphs = 0, glyph = -1;
+    int w = 0, h = 0, gx = 0, gy = 0, row = -1;
+    unsigned long bits;
+    int x;
+
+    //First pass for the cell size and glyph count
+    while (fgets(line, sizeof(line), f)) {
+        sscanf(line, "FONTBOUNDINGBOX %d %d %d %d", &cellW, &cellH, &cellX, &cellY);
+        glyphs += (strncmp(line, "STARTCHAR", 9) == 0);
+    }
+    setSize(b, cellW, cellH * glyphs);
+
+    rewind(f);
+    while (fgets(line, sizeof(line), f)) {
+        if (strncmp(line, "STARTCHAR", 9) == 0) {
+            glyph++;
+        } else if (sscanf(line, "BBX %d %d %d %d", &w, &h, &gx, &gy) == 4) {
+            continue;
+        } else if (strncmp(line, "BITMAP", 6) == 0) {
+            row = 0;
+        } else if (strncmp(line, "ENDCHAR", 7) == 0) {
+            row = -1;
+        } else if ((row >= 0) && (row < h)) {
+            //Hex row, MSB leftmost, padded to whole bytes
+            bits = strtoul(line, 0, 16);
+            for (x = 0; x < w; x++) {
+                if (bits & (1UL << (((w + 7) & ~7) - 1 - x))) {
+                    setPixel(b, gx - cellX + x,
+                             glyph * cellH + (cellH + cellY) - (gy + h) + row);
+                }
+            }
+            row++;
+        }
+    }
+}
+
+/*
+ * PackBits: runs of 3 or more equal bytes are repeats, everything else
+ * goes out as literals. Returns the packed size.
+ */
+static int pack(const uint8_t *in, int n, uint8_t *out)
+{
+    int i = 0, size = 0, lit = -1; //Index of the open literal's control byte
+    int run;
+
+    while (i < n) {
+        for (run = 1; (i + run < n) && (run < 129) && (in[i + run] == in[i]); run++) {
+        }
+        if (run >= 3) {
+            out[size++] = (uint8_t)(run + 126);
+            out[size++] = in[i];
+            i += run;
+            lit = -1;
+        } else {
+            if ((lit < 0) || (out[lit] == 127)) {
+                lit = size++;
+                out[lit] = 0xFF; //Becomes 0 with the first byte
+            }
+            out[lit]++;
+            out[size++] = in[i++];
+        }
+    }
+    return size;
+}
+
+static int unpack(const uint8_t *in, int size, uint8_t *out)
+{
+    int i = 0, n = 0, k;
+
+    while (i < size) {
+        uint8_t control = in[i++];
+
+        if (control & 0x80) {
+            for (k = 0; k < control - 126; k++) {
+                out[n++] = in[i];
+            }
+            i++;
+        } else {
+            for (k = 0; k <= control; k++) {
+                out[n++] = in[i++];
+            }
+        }
+    }
+    return n;
+}
+
+int main(void)
+{
+    int sizes[NUM_ASSETS];
+    int id, i, raw, size;
+    FILE *f;
+
+    printf("/** assets.c\n"
+           " *\n"
+           " * Generated by tools/compile_assets.c from the files listed in assets.h.\n"
+           " * Do not edit; rerun the tool instead.\n"
+           " */\n\n"
+           "#include \"assets.h\"\n");
+
+    for (id = 0; id < NUM_ASSETS; id++) {
+        Bitmap *b = &assets[id];
+        const char *ext = strrchr(b->file, '.');
+
+        f = fopen(b->file, "rb");
+        if (!f) {
+            fail(b, "cannot open");
+        }
+        if (ext && (strcmp(ext, ".bdf") == 0)) {
+            readBdf(b, f);
+        } else {
+            readPbm(b, f);
+        }
+        fclose(f);
+
+        raw = ((b->width + 7) >> 3) * b->height;
+        size = pack(b->bits, raw, packed);
+        if ((unpack(packed, size, check) != raw) || memcmp(check, b->bits, raw)) {
+            fail(b, "packed stream does not unpack to the image");
+        }
+        sizes[id] = size;
+        fprintf(stderr, "%-16s %3dx%-3d %5d -> %5d bytes (%d%%)\n",
+                b->name, b->width, b->height, raw, size, (size * 100) / raw);
+
+        printf("\n//%s, %dx%d, %d bytes unpacked\n", b->file, b->width, b->height, raw);
+        printf("#pragma DATA_SECTION(asset_%s, \".assets\")\n", b->name);
+        printf("static const uint8_t asset_%s[%d] = {", b->name, size);
+        for (i = 0; i < size; i++) {
+            printf("%s0x%02X%s", (i % 16) ? "" : "\n    ", packed[i], (i < size - 1) ? "," : "");
+        }
+        printf("\n};\n");
+    }
+
+    printf("\nconst GfxAsset g_assets[NUM_ASSETS] = {\n");
+    for (id = 0; id < NUM_ASSETS; id++) {
+        printf("    {%d, %d, %d, asset_%s},\n",
+               assets[id].width, assets[id].height, sizes[id], assets[id].name);
+    }
+    printf("};\n");
+    return 0;
+}
+
+#endif /* __MSP430__ */
@@ -0,0 +1,139 @@
+/** lcd_bus.c
+ *
+ *  Created on: Oct 19, 2026
+ *
+ * Projects the on-target LCD time of typical frames without a LaunchPad.
+ * Draws each frame below with the graphics core, flushes it through the
+ * real Sharp128x128 driver on the host HAL in lcd_host.c, and prints the
+ * bytes and projected time of the flush and of the whole frame, clears
+ * included. Run from the lab directory:
+ *
+ *   gcc -std=gnu99 -D__MSP430F5529 -Itools -I. -Igrlib -o lcd_bus \
+ *       tools/lcd_bus.c tools/lcd_host.c LcdDriver/sharp128/Sharp128x128.c \
+ *       gfx.c fonts/fontfixed6x8.c
+ *   ./lcd_bus [spi_hz [cpu_hz [byte_cycles]]]
+ *
+ * The clocks default to the ones in clock.h. Comparing runs with
+ * LCD_DOUBLE_BUFFER on and off in the HAL header, or at other clocks, shows
+ * what a change buys before it is tried on the board.
+ */
+
+#ifndef __MSP430__
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "peripherals.h"
+#include "lcd_host.h"
+
+tContext g_sContext;
+
+static void frameFullFill(void)
+{
+    Graphics_Rectangle full = {0, 0, LCD_HORIZONTAL_MAX - 1, LCD_VERTICAL_MAX - 1};
+
+    Graphics_fillRectangle(&g_sContext, &full);
+}
+
+static void frameClearLabel(void)
+{
+    Graphics_clearDisplay(&g_sContext);
+    Graphics_drawStringCentered(&g_sContext, "Push to Start", AUTO_STRING_LENGTH, 64, 75, TRANSPARENT_TEXT);
+}
+
+static void frameLabel(void)
+{
+    Graphics_drawStringCentered(&g_sContext, "Push to Start", AUTO_STRING_LENGTH, 64, 75, TRANSPARENT_TEXT);
+}
+
+static void frameRect8(void)
+{
+    Graphics_Rectangle small = {60, 60, 67, 67};
+
+    Graphics_fillRectangle(&g_sContext, &small);
+}
+
+static void frameScroll(void)
+{
+    Sharp128x128_scroll(1, ClrWhite);
+}
+
+static void frameVcomIdle(void)
+{
+    //Two timer periods with nothing drawn, then one row changes
+    Sharp128x128_SendToggleVCOMCommand();
+    Sharp128x128_SendToggleVCOMCommand();
+    Graphics_drawLineH(&g_sContext, 0, LCD_HORIZONTAL_MAX - 1, 0);
+}
+
+typedef struct {
+    const char *name;
+    void (*draw)(void);
+} Frame;
+
+static const Frame frames[] = {
+    {"full_fill", frameFullFill},
+    {"clear_label", frameClearLabel},
+    {"label", frameLabel},
+    {"rect_8x8", frameRect8},
+    {"scroll_1", frameScroll},
+    {"vcom_idle_row", frameVcomIdle},
+};
+
+int main(int argc, char **argv)
+{
+    unsigned int i;
+    uint32_t flushUs, frameUs;
+
+    if (argc > 1) {
+        g_lcdBusSpiHz = strtoul(argv[1], 0, 0);
+    }
+    if (argc > 2) {
+        g_lcdBusCpuHz = strtoul(argv[2], 0, 0);
+    }
+    if (argc > 3) {
+        g_lcdBusByteCycles = strtoul(argv[3], 0, 0);
+    }
+    if ((g_lcdBusSpiHz == 0) || (g_lcdBusCpuHz == 0)) {
+        fprintf(stderr, "usage: %s [spi_hz [cpu_hz [byte_cycles]]]\n", argv[0]);
+        return 1;
+    }
+
+    //Same context as configDisplay()
+    Graphics_initContext(&g_sContext, &g_sharp128x128LCD);
+    Graphics_setForegroundColor(&g_sContext, ClrBlack);
+    Graphics_setBackgroundColor(&g_sContext, ClrWhite);
+    Graphics_setFont(&g_sContext, &g_sFontFixed6x8);
+
+#ifdef LCD_DOUBLE_BUFFER
+    printf("flush: interrupt driven, changed rows only\n");
+#else
+    printf("flush: blocking, whole frame\n");
+#endif
+    printf("spi %lu Hz, cpu %lu Hz, %lu cycles per byte\n\n",
+           (unsigned long)g_lcdBusSpiHz, (unsigned long)g_lcdBusCpuHz,
+           (unsigned long)g_lcdBusByteCycles);
+    printf("%-14s %11s %9s %11s %9s %7s\n",
+           "frame", "flush_bytes", "flush_us", "frame_bytes", "frame_us", "max_fps");
+
+    for (i = 0; i < sizeof(frames) / sizeof(frames[0]); i++) {
+        Graphics_clearDisplay(&g_sContext);
+        Graphics_flushBuffer(&g_sContext);
+        lcdHostReset();
+
+        frames[i].draw();
+        Graphics_flushBuffer(&g_sContext);
+
+        if (g_lcdBusFlushes == 0) { //Nothing changed, so nothing was sent
+            g_lcdBusFrame = g_lcdBusFlush;
+        }
+        flushUs = lcdHostProjectUs(&g_lcdBusFlush);
+        frameUs = lcdHostProjectUs(&g_lcdBusFrame);
+        printf("%-14s %11lu %9lu %11lu %9lu %7lu\n", frames[i].name,
+               (unsigned long)g_lcdBusFlush.bytes, (unsigned long)flushUs,
+               (unsigned long)g_lcdBusFrame.bytes, (unsigned long)frameUs,
+               (unsigned long)(frameUs ? 1000000UL / frameUs : 0));
+    }
+    return 0;
+}
+
+#endif /* __MSP430__ */
@@ -0,0 +1,148 @@
+/** lcd_host.c
+ *
+ *  Created on: Oct 19, 2026
+ *
+ * Host Sharp128x128 HAL and SPI bus model. See lcd_host.h.
+ */
+
+#ifndef __MSP430__
+
+#include "lcd_host.h"
+
+#ifdef LCD_DOUBLE_BUFFER
+extern void Sharp128x128_txReady(void);
+#endif
+
+uint32_t g_lcdBusSpiHz = LCD_SPI_ACTUAL_FREQ_HZ;
+uint32_t g_lcdBusCpuHz = MCLK_FREQ_HZ;
+uint32_t g_lcdBusByteCycles = LCD_HOST_BYTE_CYCLES;
+
+LcdBusStats g_lcdBusFlush;
+LcdBusStats g_lcdBusFrame;
+uint32_t g_lcdBusFlushes;
+
+static LcdBusStats pending; //Traffic since the last flush ended
+static LcdBusStats frameStart; //pending when the current CS frame started
+static int csActive;
+static int commandNext; //The next byte is the command byte of a frame
+static int flushFrame; //The current frame is a flush
+#ifdef LCD_DOUBLE_BUFFER
+static int txEnabled;
+static int inIsr; //Sharp128x128_txReady() is being called
+#endif
+
+void lcdHostReset(void)
+{
+    static const LcdBusStats zero;
+
+    pending = zero;
+    g_lcdBusFlush = zero;
+    g_lcdBusFrame = zero;
+    g_lcdBusFlushes = 0;
+}
+
+/*
+ * Projects the on-target bus time of the given traffic in microseconds
+ */
+uint32_t lcdHostProjectUs(const LcdBusStats *stats)
+{
+    uint64_t spiPs = (8ULL * 1000000000000ULL) / g_lcdBusSpiHz;
+    uint64_t cpuPs = ((uint64_t)g_lcdBusByteCycles * 1000000000000ULL) / g_lcdBusCpuHz;
+    uint64_t bytePs = (spiPs > cpuPs) ? spiPs : cpuPs;
+
+    //The hold is a fixed 2 us that the driver counts in cycles of the MCLK
+    //it was built for
+    return (uint32_t)((stats->bytes * bytePs) / 1000000ULL
+                      + ((uint64_t)stats->holdCycles * 1000000ULL) / MCLK_FREQ_HZ);
+}
+
+void lcdHostDelayCycles(unsigned long cycles)
+{
+    pending.holdCycles += cycles;
+}
+
+void HAL_LCD_initDisplay(void)
+{
+}
+
+void HAL_LCD_writeCommandOrData(uint16_t command)
+{
+    if (commandNext) {
+        flushFrame = (command & SHARP_LCD_CMD_WRITE_LINE) != 0;
+        commandNext = 0;
+    }
+    pending.bytes++;
+}
+
+void HAL_LCD_setCS(void)
+{
+    csActive = 1;
+    commandNext = 1;
+    frameStart = pending;
+    pending.frames++;
+}
+
+void HAL_LCD_clearCS(void)
+{
+    if (!csActive) { //HAL_LCD_initDisplay() style deassert, not a frame
+        return;
+    }
+    csActive = 0;
+    if (flushFrame) {
+        g_lcdBusFlush.bytes = pending.bytes - frameStart.bytes;
+        g_lcdBusFlush.frames = pending.frames - frameStart.frames;
+        g_lcdBusFlush.holdCycles = pending.holdCycles - frameStart.holdCycles;
+        g_lcdBusFrame = pending;
+        g_lcdBusFlushes++;
+        pending.bytes = 0;
+        pending.frames = 0;
+        pending.holdCycles = 0;
+        flushFrame = 0;
+    }
+}
+
+void HAL_LCD_prepareMemoryWrite(void)
+{
+}
+
+void HAL_LCD_finishMemoryWrite(void)
+{
+}
+
+void HAL_LCD_waitUntilLcdWriteFinish(void)
+{
+}
+
+void HAL_LCD_disableDisplay(void)
+{
+}
+
+void HAL_LCD_enableDisplay(void)
+{
+}
+
+#ifdef LCD_DOUBLE_BUFFER
+/*
+ * TXBUF is always empty on the host, so the interrupt fires back to back
+ * until the driver disables it at the end of the frame
+ */
+void HAL_LCD_enableTxInterrupt(void)
+{
+    txEnabled = 1;
+    if (inIsr) {
+        return;
+    }
+    inIsr = 1;
+    while (txEnabled) {
+        Sharp128x128_txReady();
+    }
+    inIsr = 0;
+}
+
+void HAL_LCD_disableTxInterrupt(void)
+{
+    txEnabled = 0;
+}
+#endif
+
+#endif /* __MSP430__ */
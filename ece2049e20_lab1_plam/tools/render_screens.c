@@ -0,0 +1,104 @@
+/** render_screens.c
+ *
+ *  Created on: Oct 19, 2026
+ *
+ * Host build step for screen_images.c. Draws every screen in screens.h with
+ * the graphics core, label table and font the target uses, and writes the
+ * frame buffers out as C arrays. Run from the lab directory:
+ *
+ *   gcc -std=gnu99 -DSCREENS_RENDER -Itools -I. -Igrlib -o render_screens \
+ *       tools/render_screens.c gfx.c labels.c screens.c fonts/fontfixed6x8.c
+ *   ./render_screens > screen_images.c
+ *
+ * The Sharp128x128 functions the core calls are replaced by the versions
+ * below, which only keep the frame buffer.
+ */
+
+#ifndef __MSP430__
+
+#include <stdio.h>
+#include <string.h>
+#include "peripherals.h"
+#include "screens.h"
+
+#define SCREEN_NAME(id)     #id,
+
+static const char * const screenNames[NUM_SCREENS] = {
+    SCREENS(SCREEN_NAME)
+};
+
+uint8_t DisplayBuffer[LCD_VERTICAL_MAX][LCD_HORIZONTAL_MAX / 8];
+uint8_t Sharp128x128_rowBase = 0;
+tContext g_sContext;
+
+static const Graphics_Display hostLCD = {
+    sizeof(tDisplay), DisplayBuffer, LCD_HORIZONTAL_MAX, LCD_VERTICAL_MAX
+};
+
+void Sharp128x128_markSpan(int16_t lX1, int16_t lX2, int16_t lY1, int16_t lY2)
+{
+}
+
+void Sharp128x128_blitRow(int16_t lX, int16_t lY, int16_t lX0, int16_t lCount,
+                          const uint8_t *pucData, uint8_t ucFore, uint8_t ucBack)
+{
+    int16_t i, bit;
+    uint8_t *row = DisplayBuffer[lY];
+
+    for (i = 0; i < lCount; i++, lX++) {
+        bit = lX0 + i;
+        if (((pucData[bit >> 3] << (bit & 0x7)) & 0x80) ? ucFore : ucBack) {
+            row[lX >> 3] |= 0x80 >> (lX & 0x7);
+        } else {
+            row[lX >> 3] &= ~(0x80 >> (lX & 0x7));
+        }
+    }
+}
+
+void Sharp128x128_clearDisplay(uint16_t ulValue)
+{
+    memset(DisplayBuffer, (ulValue != 0) ? SHARP_WHITE : SHARP_BLACK, sizeof(DisplayBuffer));
+}
+
+void Sharp128x128_flushBuffer(void)
+{
+}
+
+int main(void)
+{
+    int id, y, x;
+
+    //Same context as configDisplay()
+    Graphics_initContext(&g_sContext, &hostLCD);
+    Graphics_setForegroundColor(&g_sContext, ClrBlack);
+    Graphics_setBackgroundColor(&g_sContext, ClrWhite);
+    Graphics_setFont(&g_sContext, &g_sFontFixed6x8);
+
+    printf("/** screen_images.c\n"
+           " *\n"
+           " * Generated by tools/render_screens.c from screens.c and labels.h.\n"
+           " * Do not edit; rerun the tool instead.\n"
+           " */\n\n"
+           "#include \"screens.h\"\n\n"
+           "#ifdef SCREEN_IMAGES\n\n"
+           "#pragma DATA_SECTION(g_screenImages, \".screens\")\n"
+           "const uint8_t g_screenImages[NUM_SCREENS][LCD_VERTICAL_MAX][LCD_HORIZONTAL_MAX / 8] = {\n");
+
+    for (id = 0; id < NUM_SCREENS; id++) {
+        screenDrawLabels(id);
+        printf("    { //%s\n", screenNames[id]);
+        for (y = 0; y < LCD_VERTICAL_MAX; y++) {
+            printf("        {");
+            for (x = 0; x < LCD_HORIZONTAL_MAX / 8; x++) {
+                printf("0x%02X%s", DisplayBuffer[y][x], (x < LCD_HORIZONTAL_MAX / 8 - 1) ? "," : "");
+            }
+            printf("},\n");
+        }
+        printf("    },\n");
+    }
+
+    printf("};\n\n#endif\n");
+    return 0;
+}
+
+#endif /* __MSP430__ */
@@ -0,0 +1,140 @@
+/*
+ * bench.c
+ *
+ *  Created on: Oct 19, 2026
+ *
+ * JSON reporting for the benchmark harness and the graphics workloads
+ * shared by both labs. Lab specific workloads live next to the code they
+ * exercise and are run from that lab's runBenchmarks().
+ */
+
+#include "bench.h"
+
+#ifdef BENCH_ENABLE
+
+#include "peripherals.h"
+#include "images/images.h"
+
+#ifdef GFX_CORE
+#include "assets.h"
+
+extern char gfxTextSize; //Size of .text:gfx, set by the linker
+#endif
+
+static void benchPutField(const char *key, uint32_t v)
+{
+    char buf[12];
+
+    profileUartPuts(key);
+    profileFormatU32(buf, v, 0);
+    profileUartPuts(buf);
+}
+
+#ifdef GFX_CORE
+/*
+ * Writes the unpacked and packed size of an asset, to sit next to its
+ * decode time
+ */
+static void benchAssetReport(const char *name, const GfxAsset *asset)
+{
+    profileUartPuts("{\"asset\":\"");
+    profileUartPuts(name);
+    benchPutField("\",\"raw_bytes\":", GFX_ASSET_RAW_SIZE(asset));
+    benchPutField(",\"packed_bytes\":", asset->size);
+    benchPutField(",\"ratio_pct\":", ((uint32_t)asset->size * 100) / GFX_ASSET_RAW_SIZE(asset));
+    profileUartPuts("}\r\n");
+}
+
+//Size line and decode time of every asset; each one is drawn whole from a
+//byte boundary
+#define BENCH_ASSET(id, name, file) \
+    benchAssetReport(name, &g_assets[id]); \
+    BENCH("draw_asset_" name, 16, gfxDrawAsset(&g_sContext, &g_assets[id], 16, 16));
+#endif
+
+/*
+ * Opens a benchmark run on the UART
+ */
+void benchBegin(void)
+{
+    profileUartInit();
+    profileUartPuts("{\"suite\":\"begin\"}\r\n");
+}
+
+/*
+ * Closes a benchmark run
+ */
+void benchEnd(void)
+{
+    profileUartPuts("{\"suite\":\"end\"}\r\n");
+}
+
+/*
+ * Writes one JSON line for a finished workload
+ */
+void benchReport(const char *name, const ProfileEntry *e)
+{
+    uint32_t mean = 0;
+
+    if (e->count != 0) {
+        mean = PROFILE_TICKS_TO_US(e->total / e->count);
+    }
+
+    profileUartPuts("{\"bench\":\"");
+    profileUartPuts(name);
+    benchPutField("\",\"n\":", e->count);
+    benchPutField(",\"min_us\":", PROFILE_TICKS_TO_US(e->min));
+    benchPutField(",\"mean_us\":", mean);
+    benchPutField(",\"max_us\":", PROFILE_TICKS_TO_US(e->max));
+    profileUartPuts("}\r\n");
+}
+
+/*
+ * Display driver and text workloads common to both labs
+ */
+void benchGraphics(void)
+{
+    Graphics_Rectangle small = {60, 60, 67, 67};
+    Graphics_Rectangle medium = {48, 48, 79, 79};
+    Graphics_Rectangle full = {0, 0, LCD_HORIZONTAL_MAX - 1, LCD_VERTICAL_MAX - 1};
+
+    BENCH("flush", 16, Graphics_flushBuffer(&g_sContext));
+    BENCH("clear_screen", 16, Graphics_clearDisplay(&g_sContext));
+    BENCH("rect_fill_8x8", 64, Graphics_fillRectangle(&g_sContext, &small));
+    BENCH("rect_fill_32x32", 64, Graphics_fillRectangle(&g_sContext, &medium));
+    Graphics_setForegroundColor(&g_sContext, ClrInvert); //A selection highlight
+    BENCH("rect_invert_32x32", 64, Graphics_fillRectangle(&g_sContext, &medium));
+    Graphics_setForegroundColor(&g_sContext, ClrBlack);
+    BENCH("rect_fill_full", 16, Graphics_fillRectangle(&g_sContext, &full));
+    BENCH("draw_string_centered", 64,
+          Graphics_drawStringCentered(&g_sContext, "Push to Start", AUTO_STRING_LENGTH, 64, 75, TRANSPARENT_TEXT));
+    //The full 69x64 logo, starting mid-byte and then on a byte boundary
+    BENCH("draw_image_logo", 16,
+          Graphics_drawImage(&g_sContext, &TI_Logo_69x64_1BPP_UNCOMP, 29, 32));
+    BENCH("draw_image_logo_aligned", 16,
+          Graphics_drawImage(&g_sContext, &TI_Logo_69x64_1BPP_UNCOMP, 32, 32));
+
+#ifdef GFX_CORE
+    //The drawing workloads above ran on the graphics core; run them through
+    //grlib.lib as well. The parentheses keep gfx.h's macros from expanding.
+    BENCH("grlib_rect_fill_8x8", 64, (Graphics_fillRectangle)(&g_sContext, &small));
+    BENCH("grlib_rect_fill_32x32", 64, (Graphics_fillRectangle)(&g_sContext, &medium));
+    (Graphics_setForegroundColor)(&g_sContext, ClrInvert);
+    BENCH("grlib_rect_invert_32x32", 64, (Graphics_fillRectangle)(&g_sContext, &medium));
+    (Graphics_setForegroundColor)(&g_sContext, ClrBlack);
+    BENCH("grlib_rect_fill_full", 16, (Graphics_fillRectangle)(&g_sContext, &full));
+    BENCH("grlib_draw_string_centered", 64,
+          (Graphics_drawStringCentered)(&g_sContext, (uint8_t *)"Push to Start", AUTO_STRING_LENGTH, 64, 75, TRANSPARENT_TEXT));
+    BENCH("grlib_draw_image_logo", 16,
+          (Graphics_drawImage)(&g_sContext, &TI_Logo_69x64_1BPP_UNCOMP, 29, 32));
+
+    benchPutField("{\"size\":\"gfx_text\",\"bytes\":", _symval(&gfxTextSize));
+    profileUartPuts("}\r\n");
+
+    ASSETS(BENCH_ASSET)
+#endif
+
+    Graphics_clearDisplay(&g_sContext);
+}
+
+#endif /* BENCH_ENABLE */
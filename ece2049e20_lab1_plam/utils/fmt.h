@@ -0,0 +1,27 @@
+/** fmt.h
+ *
+ *  Created on: Oct 19, 2026
+ *
+ * Fixed-purpose integer formatters for display text, in place of
+ * usnprintf(buf, n, "%d", value) on paths that only ever print one small
+ * integer. They take no format string or variable argument list and use no
+ * division: decimal digits come from subtracting powers of ten, hex digits
+ * from shifts. Each one NUL terminates the buffer and returns the number of
+ * characters written before the NUL.
+ */
+
+#ifndef FMT_H_
+#define FMT_H_
+
+#include <stdint.h>
+
+// Buffer sizes, NUL included
+#define FMT_U16_SIZE    6   // "65535"
+#define FMT_I16_SIZE    7   // "-32768"
+
+int fmt_u16(unsigned char *buf, uint16_t value);
+int fmt_i16(unsigned char *buf, int16_t value);
+int fmt_u16_pad(unsigned char *buf, uint16_t value, int width, char pad);
+int fmt_hex16(unsigned char *buf, uint16_t value, int digits);
+
+#endif /* FMT_H_ */
@@ -49,6 +49,11 @@
 
 #include <LcdDriver/sharp128/HAL_MSP_EXP430F5529_Sharp128x128.h>
 
+#ifdef LCD_DOUBLE_BUFFER
+// Sends the next byte of an interrupt-driven flush, in Sharp128x128.c
+extern void Sharp128x128_txReady(void);
+#endif
+
 
 //*****************************************************************************
 //
@@ -98,8 +103,8 @@ void HAL_LCD_initDisplay(void)
     EUSCI_B_SPI_initMasterParam spiMasterParams =
     {
         EUSCI_B_SPI_CLOCKSOURCE_SMCLK,
-        8000000,
-        1000000,
+        SMCLK_FREQ_HZ,
+        LCD_SPI_FREQ_HZ,
         EUSCI_B_SPI_MSB_FIRST,
         EUSCI_B_SPI_PHASE_DATA_CAPTURED_ONFIRST_CHANGED_ON_NEXT,
         EUSCI_B_SPI_CLOCKPOLARITY_INACTIVITY_LOW,
@@ -143,7 +148,7 @@ void HAL_LCD_initDisplay(void)
 
     SPI_REG_CTL1 |= SPI_CLK_SRC; // Select SMCLK for our clock source
 
-    // Set SPI clock frequency (which is the same frequency as SMCLK so this can apparently be 0)
+    // Set SPI clock frequency (SMCLK / SPI_CLK_TICKS)
     SPI_REG_BRL  =  ((uint16_t)SPI_CLK_TICKS) & 0xFF;         // Load the low byte
     SPI_REG_BRH  = (((uint16_t)SPI_CLK_TICKS) >> 8) & 0xFF;   // Load the high byte
 
@@ -307,6 +312,47 @@ void HAL_LCD_finishMemoryWrite()
     __no_operation();
 }
 
+#ifdef LCD_DOUBLE_BUFFER
+//*****************************************************************************
+//
+// Enables the SPI transmit interrupt. It fires as soon as TXBUF is empty.
+//
+// \return None
+//
+//*****************************************************************************
+void HAL_LCD_enableTxInterrupt(void)
+{
+    SPI_REG_IE |= UCTXIE;
+}
+
+//*****************************************************************************
+//
+// Disables the SPI transmit interrupt
+//
+// \return None
+//
+//*****************************************************************************
+void HAL_LCD_disableTxInterrupt(void)
+{
+    SPI_REG_IE &= ~UCTXIE;
+}
+
+//*****************************************************************************
+//
+// SPI interrupt. Only TX is enabled; UCB0IV is not read because RXIFG, which
+// every sent byte sets, has the higher priority and would be returned first.
+//
+//*****************************************************************************
+#pragma vector=SPI_VECTOR
+__interrupt void HAL_LCD_spiISR(void)
+{
+    if(SPI_REG_IFG & UCTXIFG)
+    {
+        Sharp128x128_txReady();
+    }
+}
+#endif
+
 //*****************************************************************************
 //
 // Close the Doxygen group.
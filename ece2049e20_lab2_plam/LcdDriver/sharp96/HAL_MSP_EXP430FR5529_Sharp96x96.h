@@ -54,6 +54,7 @@
 #define __HAL_MSP_EXP430F5529_SHARPLCD_H__
 
 #include<msp430.h>
+#include "clock.h"
 
 #ifdef USE_DRIVERLIB
 #include "inc/hw_memmap.h"
@@ -127,11 +128,11 @@
  * The actual clock frequency is given in number of
  * ticks of the specified clock source.
  *
- * For our configuration, we use the same frequency
- * as SMCLK, which is 1.25MHz.
+ * SMCLK is divided down to LCD_SPI_FREQ_HZ; both are
+ * configured in clock.h.
  */
 #define SPI_CLK_SRC		(UCSSEL__SMCLK)
-#define SPI_CLK_TICKS	0
+#define SPI_CLK_TICKS	LCD_SPI_CLK_TICKS
 
 // LCD Screen Dimensions
 //#define LCD_VERTICAL_MAX                   96
@@ -80,6 +80,9 @@ static void Sharp96x96_InitializeDisplayBuffer(void *pvDisplayData, uint8_t ucVa
 
 
 #ifndef NON_VOLATILE_MEMORY_BUFFER
+#ifdef LCD_BUFFER_USBRAM
+#pragma DATA_SECTION(DisplayBuffer, ".lcdbuf")
+#endif //LCD_BUFFER_USBRAM
 static uint8_t DisplayBuffer[LCD_VERTICAL_MAX][LCD_HORIZONTAL_MAX/8];
 #else
 #ifdef __ICC430__
@@ -172,9 +175,10 @@ void Sharp96x96_PixelDraw(void *pvDisplayData, int16_t lX, int16_t lY,
 //! contains 24-bit RGB values that must be translated before being written to
 //! the display.
 //!
-//! NOTE:  This function currently does not support 90 degree rotation.
-//! A workaround for now is to rotate images 90 degrees when creating
-//! them.
+//! Without ROTATE_90, 1 bit per pixel runs are shifted into place through a
+//! 16 bit window and written a byte at a time, whatever the alignment of lX
+//! and lX0; only the first and last byte are merged with the row. With
+//! ROTATE_90 a run is a column of the buffer and is drawn a pixel at a time.
 //!
 //! \return None.
 //
@@ -186,20 +190,81 @@ static void Sharp96x96_DrawMultiple(void *pvDisplayData, int16_t lX,
                                            const uint32_t *pucPalette)
 {  
 
-	uint8_t *pData = &DisplayBuffer[lY][lX>>3];
-	uint16_t xj = 0;
+	int16_t xj;
+	uint8_t ucIndex;
 
 #ifdef NON_VOLATILE_MEMORY_BUFFER
 	PrepareMemoryWrite();
 #endif
 
-	//Write bytes of data to the display buffer
-	for(xj=0;xj<lCount>>3;xj++){
-		*pData++ = *pucData++;
-	}
+#ifndef ROTATE_90
+	if(lBPP == 1){
+		uint8_t *pData = &DisplayBuffer[lY][lX>>3];
+		int16_t lLast = lX + lCount - 1;
+		int16_t xi = (lLast>>3) - (lX>>3);
+		int16_t lLeft = ((lX0 + lCount - 1)>>3) + 1;
+		uint8_t ucFirst = 0xFF >> (lX & 0x7);
+		uint8_t ucEnd = 0xFF << (7-(lLast & 0x7));
+		uint8_t ucFore = pucPalette[1] ? SHARP_WHITE : SHARP_BLACK;
+		uint8_t ucBack = pucPalette[0] ? SHARP_WHITE : SHARP_BLACK;
+		uint8_t ucMask = ucFore ^ ucBack;
+		uint8_t ucShift, ucOut;
+		uint16_t uiWindow = 0;
+
+		//a run that starts further into its first byte than into the row
+		//takes the first buffer byte from two data bytes
+		if(lX0 > (lX & 0x7)){
+			uiWindow = *pucData++;
+			lLeft--;
+			ucShift = 8 + (lX & 0x7) - lX0;
+		}else{
+			ucShift = (lX & 0x7) - lX0;
+		}
 
-	//Write last data byte to the display buffer
-	*pData = (*pData & (0xFF >> (lCount & 0x7))) | *pucData;
+		if(xi == 0){
+			ucFirst &= ucEnd;
+		}
+		for(xj=0;xj<=xi;xj++){
+			uiWindow = (uiWindow << 8) | ((lLeft-- > 0) ? *pucData++ : 0);
+			ucOut = ((uint8_t)(uiWindow >> ucShift) & ucMask) ^ ucBack;
+			if(xj == 0){
+				*pData = (*pData & ~ucFirst) | (ucOut & ucFirst);
+			}else if(xj == xi){
+				*pData = (*pData & ~ucEnd) | (ucOut & ucEnd);
+			}else{
+				*pData = ucOut;
+			}
+			pData++;
+		}
+	}else
+#endif
+	{
+		//a pixel at a time; for 4 and 8 bit per pixel data any palette
+		//color but black is white
+		for(xj=0;xj<lCount;xj++){
+			if(lBPP == 1){
+				ucIndex = (pucData[(lX0 + xj)>>3] >> (7-((lX0 + xj) & 0x7))) & 1;
+			}else if(lBPP == 4){
+				ucIndex = pucData[(lX0 + xj)>>1];
+				ucIndex = ((lX0 + xj) & 1) ? (ucIndex & 0x0F) : (ucIndex >> 4);
+			}else{
+				ucIndex = pucData[xj];
+			}
+#ifdef ROTATE_90
+			if(ClrBlack == pucPalette[ucIndex]){
+				DisplayBuffer[LCD_HORIZONTAL_MAX - (lX + xj) - 1][lY>>3] &= ~(0x80 >> (lY & 0x7));
+			}else{
+				DisplayBuffer[LCD_HORIZONTAL_MAX - (lX + xj) - 1][lY>>3] |= (0x80 >> (lY & 0x7));
+			}
+#else
+			if(ClrBlack == pucPalette[ucIndex]){
+				DisplayBuffer[lY][(lX + xj)>>3] &= ~(0x80 >> ((lX + xj) & 0x7));
+			}else{
+				DisplayBuffer[lY][(lX + xj)>>3] |= (0x80 >> ((lX + xj) & 0x7));
+			}
+#endif
+		}
+	}
 
 #ifdef NON_VOLATILE_MEMORY_BUFFER
 	FinishMemoryWrite();
@@ -580,7 +645,7 @@ void Sharp96x96_Flush (void *pvDisplayData)
 	WaitUntilLcdWriteFinished();
 
     // Ensure a 2us min delay to meet the LCD's thSCS
-    __delay_cycles(SYSTEM_CLOCK_SPEED * 0.000002);
+    __delay_cycles(LCD_CS_HOLD_CYCLES);
 
 	DeassertCS();
 }
@@ -615,7 +680,7 @@ void Sharp96x96_ClearScreen (void *pvDisplayData, uint16_t ulValue)
 	WaitUntilLcdWriteFinished();
 
 	// Ensure a 2us min delay to meet the LCD's thSCS
-	__delay_cycles(SYSTEM_CLOCK_SPEED * 0.000002);
+	__delay_cycles(LCD_CS_HOLD_CYCLES);
 
 	DeassertCS();
 	if(ClrBlack == ulValue)
@@ -655,7 +720,7 @@ void Sharp96x96_SendToggleVCOMCommand()
 		WaitUntilLcdWriteFinished();
 
 		// Ensure a 2us min delay to meet the LCD's thSCS
-		__delay_cycles(SYSTEM_CLOCK_SPEED * 0.000002);
+		__delay_cycles(LCD_CS_HOLD_CYCLES);
 
 		DeassertCS();
 	}
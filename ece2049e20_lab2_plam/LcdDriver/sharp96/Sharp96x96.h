@@ -46,8 +46,11 @@
 //
 //*****************************************************************************
 
-// SYSTEM_CLOCK_SPEED (in Hz) allows to properly closeout SPI communication
-#define SYSTEM_CLOCK_SPEED      8000000
+#include "clock.h"
+
+// SYSTEM_CLOCK_SPEED (in Hz) allows to properly closeout SPI communication.
+// It follows the MCLK setting in clock.h.
+#define SYSTEM_CLOCK_SPEED      MCLK_FREQ_HZ
 
 // Define LCD Screen Orientation Here
 #define LANDSCAPE
@@ -59,6 +62,9 @@
 //Maximum Colors in an image color palette
 #define MAX_PALETTE_COLORS  2
 
+// Place DisplayBuffer in the .lcdbuf section (USBRAM), see Sharp128x128.h
+#define LCD_BUFFER_USBRAM
+
 #define SHARP_BLACK							0x00
 #define SHARP_WHITE							0xFF
 
@@ -0,0 +1,42 @@
+/** assets.h
+ *
+ *  Created on: Oct 19, 2026
+ *
+ * Compressed 1-bpp graphics. Every asset is listed once in ASSETS() with
+ * its name and source file, a PBM image (P1 or P4, 1 is ink) or a BDF font
+ * whose glyphs are stacked top to bottom in cells of the font bounding box.
+ * tools/compile_assets.c reads the files, packs each one as a PackBits
+ * stream (see gfxDrawAsset() in gfx.c) and writes assets.c, which puts the
+ * streams in FLASH2 and the index in g_assets[]. It also prints the
+ * compression ratio of every asset; the benchmark suite reports the ratio
+ * again next to the decode time.
+ *
+ * assets.c has to be regenerated after changing this list or a source
+ * file. Run from the lab directory:
+ *
+ *   gcc -std=gnu99 -Itools -I. -Igrlib -o compile_assets tools/compile_assets.c
+ *   ./compile_assets > assets.c
+ *
+ * Other formats can be converted to PBM first, e.g. with ImageMagick's
+ * "convert in.png -monochrome out.pbm".
+ */
+
+#ifndef ASSETS_H_
+#define ASSETS_H_
+
+#include "peripherals.h"
+
+#define ASSETS(X) \
+    X(ASSET_TI_LOGO,    "ti_logo",      "assets/ti_logo.pbm") \
+    X(ASSET_LP_ROCKET,  "lp_rocket",    "assets/lp_rocket.pbm")
+
+#define ASSET_ID(id, name, file)    id,
+
+typedef enum {
+    ASSETS(ASSET_ID)
+    NUM_ASSETS
+} assetId;
+
+extern const GfxAsset g_assets[NUM_ASSETS];
+
+#endif
@@ -0,0 +1,297 @@
+/** bench_host.c
+ *
+ *  Created on: Oct 19, 2026
+ *
+ * Timing, JSON reporting and baseline comparison for the host benchmark
+ * suite, and the graphics workloads shared by both labs. See bench_host.h.
+ * The lab workloads and main() are in bench_lab.c.
+ */
+
+#ifndef __MSP430__
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "peripherals.h"
+#include "lcd_host.h"
+#include "bench_host.h"
+
+#define BENCH_HOST_MAX_WORKLOADS    64
+
+typedef struct {
+    char name[40];
+    uint32_t n;             // Iterations in the fastest batch
+    uint32_t ns;            // Mean time of one iteration in that batch
+    uint32_t busUs;         // 0 if the workload does not flush
+} BenchHostResult;
+
+tContext g_sContext;
+
+static BenchHostResult results[BENCH_HOST_MAX_WORKLOADS];
+static int numResults;
+static BenchHostResult baselines[BENCH_HOST_MAX_WORKLOADS];
+static int numBaselines;
+static int pass;
+
+static BenchHostResult *benchHostFind(BenchHostResult *table, int count, const char *name)
+{
+    int i;
+
+    for (i = 0; i < count; i++) {
+        if (strcmp(table[i].name, name) == 0) {
+            return &table[i];
+        }
+    }
+    return NULL;
+}
+
+/*
+ * Reads the bench lines of a previous run's output
+ */
+static void benchHostLoad(const char *path)
+{
+    FILE *f = fopen(path, "r");
+    char line[256];
+    char *p, *q;
+
+    if (f == NULL) {
+        perror(path);
+        exit(1);
+    }
+    while ((numBaselines < BENCH_HOST_MAX_WORKLOADS) && fgets(line, sizeof(line), f)) {
+        BenchHostResult *b = &baselines[numBaselines];
+
+        p = strstr(line, "\"bench\":\"");
+        if (p == NULL) {
+            continue; //Suite begin/end lines
+        }
+        p += strlen("\"bench\":\"");
+        q = strchr(p, '"');
+        if ((q == NULL) || ((q - p) >= (int)sizeof(b->name))) {
+            continue;
+        }
+        memcpy(b->name, p, q - p);
+        b->name[q - p] = '\0';
+
+        p = strstr(q, "\"ns\":");
+        b->ns = p ? strtoul(p + strlen("\"ns\":"), NULL, 10) : 0;
+        p = strstr(q, "\"bus_us\":");
+        b->busUs = p ? strtoul(p + strlen("\"bus_us\":"), NULL, 10) : 0;
+        numBaselines++;
+    }
+    fclose(f);
+}
+
+/*
+ * Writes one JSON line for a workload and compares it with its baseline.
+ * Only bus_us decides a regression; ns is scaled by the host's speed, in per
+ * mille of the baseline's, for delta_pct. Returns 1 if it regressed.
+ */
+static int benchHostWrite(const BenchHostResult *r, uint32_t speed)
+{
+    const BenchHostResult *b = benchHostFind(baselines, numBaselines, r->name);
+    int64_t now, then;
+    int regressed;
+
+    printf("{\"bench\":\"%s\",\"n\":%lu,\"ns\":%lu", r->name,
+           (unsigned long)r->n, (unsigned long)r->ns);
+    if (r->busUs != 0) {
+        printf(",\"bus_us\":%lu", (unsigned long)r->busUs);
+    }
+
+    if ((b == NULL) || (b->ns == 0)) {
+        printf(",\"baseline_ns\":null}\n");
+        return 0;
+    }
+    now = (int64_t)r->ns * 1000;
+    then = (int64_t)b->ns * speed;
+    regressed = (r->busUs > b->busUs);
+    printf(",\"baseline_ns\":%lu,\"delta_pct\":%ld", (unsigned long)b->ns,
+           (long)((now - then) * 100 / then));
+    if (b->busUs != 0) {
+        printf(",\"baseline_bus_us\":%lu", (unsigned long)b->busUs);
+    }
+    printf(",\"regression\":%s}\n", regressed ? "true" : "false");
+    return regressed;
+}
+
+static int benchHostCompare(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+/*
+ * Returns the median of the workloads' ns over their baselines, in per
+ * mille, or 1000 without a baseline
+ */
+static uint32_t benchHostSpeed(void)
+{
+    uint32_t ratios[BENCH_HOST_MAX_WORKLOADS];
+    const BenchHostResult *b;
+    int count = 0;
+    int i;
+
+    for (i = 0; i < numResults; i++) {
+        b = benchHostFind(baselines, numBaselines, results[i].name);
+        if ((b != NULL) && (b->ns != 0)) {
+            ratios[count++] = (uint32_t)(((uint64_t)results[i].ns * 1000) / b->ns);
+        }
+    }
+    if (count == 0) {
+        return 1000;
+    }
+    qsort(ratios, count, sizeof(ratios[0]), benchHostCompare);
+    return ratios[count / 2];
+}
+
+/*
+ * Sets up the display as configDisplay() does and loads the baseline named
+ * on the command line, if any
+ */
+void benchHostBegin(int argc, char **argv)
+{
+    if (argc > 2) {
+        fprintf(stderr, "usage: %s [baseline.json]\n", argv[0]);
+        exit(1);
+    }
+    if (argc == 2) {
+        benchHostLoad(argv[1]);
+    }
+    numResults = 0;
+    pass = 0;
+
+    Graphics_initContext(&g_sContext, &g_sharp128x128LCD);
+    Graphics_setForegroundColor(&g_sContext, ClrBlack);
+    Graphics_setBackgroundColor(&g_sContext, ClrWhite);
+    Graphics_setFont(&g_sContext, &g_sFontFixed6x8);
+}
+
+/*
+ * Starts the next pass over the suite with a blank screen. Returns 0 after
+ * BENCH_HOST_PASSES passes.
+ */
+int benchHostPass(void)
+{
+    Graphics_clearDisplay(&g_sContext);
+    Graphics_flushBuffer(&g_sContext);
+    return pass++ < BENCH_HOST_PASSES;
+}
+
+/*
+ * Writes the results and returns the number of regressions found
+ */
+int benchHostEnd(void)
+{
+    uint32_t speed = benchHostSpeed();
+    int regressions = 0;
+    int i;
+
+    printf("{\"suite\":\"begin\",\"speed_pct\":%lu}\n", (unsigned long)(speed / 10));
+    for (i = 0; i < numResults; i++) {
+        regressions += benchHostWrite(&results[i], speed);
+    }
+    printf("{\"suite\":\"end\",\"regressions\":%d}\n", regressions);
+    return regressions;
+}
+
+void benchHostStart(BenchHostRun *run)
+{
+    run->iterations = 0;
+    run->repeats = BENCH_HOST_REPEATS;
+    run->best = UINT32_MAX;
+    lcdHostReset();
+}
+
+/*
+ * Called before each batch and once after the last. Doubles the batch until
+ * one takes BENCH_HOST_BATCH_US, then keeps the fastest of
+ * BENCH_HOST_REPEATS batches of that size. Returns 0 when done.
+ */
+int benchHostNext(BenchHostRun *run)
+{
+    profileTicks now = PROFILE_NOW();
+    uint32_t elapsed = now - run->start;
+
+    if (run->iterations == 0) {
+        run->iterations = 1;
+    } else if ((run->best == UINT32_MAX) && (elapsed < BENCH_HOST_BATCH_US)) {
+        run->iterations *= 2;
+    } else {
+        if (elapsed < run->best) {
+            run->best = elapsed;
+        }
+        if (--run->repeats == 0) {
+            return 0;
+        }
+    }
+    run->start = PROFILE_NOW();
+    return 1;
+}
+
+/*
+ * Keeps a finished workload's time if it beats the earlier passes, and the
+ * bus time of its last flush. A workload that draws without flushing is
+ * flushed here, after the timing, so its bus_us is what sending its drawing
+ * costs.
+ */
+void benchHostReport(const char *name, const BenchHostRun *run)
+{
+    BenchHostResult *r = benchHostFind(results, numResults, name);
+    uint32_t ns = (uint32_t)(((uint64_t)run->best * 1000000000ULL)
+                             / ((uint64_t)PROFILE_TICK_HZ * run->iterations));
+
+    if (r == NULL) {
+        if (numResults == BENCH_HOST_MAX_WORKLOADS) {
+            fprintf(stderr, "bench_host: more than %d workloads\n", BENCH_HOST_MAX_WORKLOADS);
+            exit(1);
+        }
+        r = &results[numResults++];
+        strncpy(r->name, name, sizeof(r->name) - 1);
+        r->ns = UINT32_MAX;
+    }
+    if (ns < r->ns) {
+        r->n = run->iterations;
+        r->ns = ns;
+    }
+    if (g_lcdBusFlushes == 0) {
+        Graphics_flushBuffer(&g_sContext); //Sends nothing if no row changed
+    }
+    r->busUs = (g_lcdBusFlushes != 0) ? lcdHostProjectUs(&g_lcdBusFlush) : 0;
+}
+
+/*
+ * Display driver and text workloads common to both labs
+ */
+void benchHostGraphics(void)
+{
+    Graphics_Rectangle small = {60, 60, 67, 67};
+    Graphics_Rectangle medium = {48, 48, 79, 79};
+    Graphics_Rectangle full = {0, 0, LCD_HORIZONTAL_MAX - 1, LCD_VERTICAL_MAX - 1};
+
+    //Every row changed, so every row is sent; rect_fill_full is the fill's
+    //share of the time. Then the common case of a frame with no changes.
+    BENCH_HOST("flush_full",
+               Graphics_fillRectangle(&g_sContext, &full);
+               Graphics_flushBuffer(&g_sContext));
+    BENCH_HOST("flush_idle",
+               Graphics_flushBuffer(&g_sContext));
+    BENCH_HOST("clear_screen",
+               Graphics_clearDisplay(&g_sContext));
+    BENCH_HOST("rect_fill_8x8",
+               Graphics_fillRectangle(&g_sContext, &small));
+    BENCH_HOST("rect_fill_32x32",
+               Graphics_fillRectangle(&g_sContext, &medium));
+    Graphics_setForegroundColor(&g_sContext, ClrInvert); //A selection highlight
+    BENCH_HOST("rect_invert_32x32",
+               Graphics_fillRectangle(&g_sContext, &medium));
+    Graphics_setForegroundColor(&g_sContext, ClrBlack);
+    BENCH_HOST("rect_fill_full",
+               Graphics_fillRectangle(&g_sContext, &full));
+    BENCH_HOST("draw_string_centered",
+               Graphics_drawStringCentered(&g_sContext, "Push to Start", AUTO_STRING_LENGTH, 64, 75, TRANSPARENT_TEXT));
+}
+
+#endif /* __MSP430__ */
@@ -0,0 +1,85 @@
+/** bench_host.h
+ *
+ *  Created on: Oct 19, 2026
+ *
+ * Host build of the benchmark suite. The workloads run the same gfx.c,
+ * Sharp128x128 driver and lab code as on target, with tools/lcd_host.c in
+ * place of the display HAL, and are timed with the host clock from
+ * utils/profile.h. Each one is reported as a JSON line in the format of the
+ * on-target suite, e.g.
+ *
+ *  {"bench":"flush_full","n":8192,"ns":2140,"bus_us":18450,"baseline_ns":2100,
+ *   "delta_pct":1,"baseline_bus_us":18450,"regression":false}
+ *
+ * ns is the mean time of one iteration in the fastest batch of the run.
+ * Each workload runs BENCH_HOST_REPEATS batches in each of BENCH_HOST_PASSES
+ * passes over the suite, each batch long enough to hide the clock's
+ * resolution. bus_us is the projected on-target SPI time of the workload's
+ * last flush. A workload that only draws is flushed once after it is timed,
+ * so its bus_us is the cost of sending what it drew. bus_us is only written
+ * if something was sent. The lines are written when the run ends.
+ *
+ * bench/baseline.json holds the output of a reference run. Given its path
+ * the suite flags a workload whose bus_us exceeds its baseline, and exits
+ * with the number of regressions. bus_us comes from the driver's own bytes
+ * and frames, so it is the same on every run and every host, and a flag is
+ * always a real change. Host times are not: on a shared machine a workload
+ * can swing by half between runs of the same tree, so ns is reported but
+ * never flagged. delta_pct compares it with the baseline after scaling by
+ * the host's speed, the median over all workloads of ns over the
+ * baseline's ns, which the suite's begin line reports as speed_pct. A
+ * workload well off the others' delta_pct is worth a look, and the
+ * on-target suite's Timer A0 counts are the figures to trust. Workloads
+ * that do not draw, such as shuffling or number formatting, have no bus_us
+ * and are timed for information only.
+ *
+ * After an intended change, regenerate the baseline from the lab directory
+ * with ./bench_host > bench/baseline.json.
+ */
+
+#ifndef BENCH_HOST_H_
+#define BENCH_HOST_H_
+
+#include <stdint.h>
+#include "utils/profile.h"
+
+#if !defined(PROFILE_ENABLE)
+#error "bench_host needs the host profiling clock: build with -DPROFILE_ENABLE"
+#endif
+
+#define BENCH_HOST_PASSES           7
+#define BENCH_HOST_REPEATS          3       // Timed batches per pass
+#define BENCH_HOST_BATCH_US         5000    // Shortest batch that is timed
+
+typedef struct {
+    uint32_t iterations;    // Iterations per batch, doubled until a batch is long enough
+    int repeats;            // Timed batches left to run
+    profileTicks start;     // Start of the running batch
+    uint32_t best;          // Shortest timed batch, in ticks
+} BenchHostRun;
+
+/*
+ * Runs code in batches until its time per iteration is known and records it
+ * as name
+ */
+#define BENCH_HOST(name, code) do { \
+    BenchHostRun _run; \
+    uint32_t _i; \
+    benchHostStart(&_run); \
+    while (benchHostNext(&_run)) { \
+        for (_i = 0; _i < _run.iterations; _i++) { \
+            code; \
+        } \
+    } \
+    benchHostReport((name), &_run); \
+} while (0)
+
+void benchHostBegin(int argc, char **argv);
+int benchHostPass(void);
+int benchHostEnd(void);
+void benchHostStart(BenchHostRun *run);
+int benchHostNext(BenchHostRun *run);
+void benchHostReport(const char *name, const BenchHostRun *run);
+void benchHostGraphics(void);
+
+#endif /* BENCH_HOST_H_ */
@@ -0,0 +1,56 @@
+/** bench_lab.c
+ *
+ *  Created on: Oct 19, 2026
+ *
+ * Host benchmark suite for MSP430 Hero: the shared graphics workloads, the
+ * score formatting of utils/fmt.c against usnprintf, and the labels of
+ * labels.c. Run from the lab directory:
+ *
+ *   gcc -std=gnu99 -O2 -DPROFILE_ENABLE -D__MSP430F5529 -Itools -I. -Igrlib \
+ *       -o bench_host bench/bench_lab.c bench/bench_host.c tools/lcd_host.c \
+ *       LcdDriver/sharp128/Sharp128x128.c gfx.c fonts/fontfixed6x8.c \
+ *       utils/profile.c utils/fmt.c utils/ustdlib.c labels.c
+ *   ./bench_host bench/baseline.json
+ *
+ * See bench_host.h for the output and the regression check.
+ */
+
+#ifndef __MSP430__
+
+#include "peripherals.h"
+#include "labels.h"
+#include "utils/fmt.h"
+#include "utils/ustdlib.h"
+#include "bench_host.h"
+
+int main(int argc, char **argv)
+{
+    unsigned char buf[FMT_I16_SIZE];
+    int n = 0;
+
+    benchHostBegin(argc, argv);
+
+    while (benchHostPass()) {
+        benchHostGraphics();
+
+        //The same values through the general formatter and the one the
+        //score screens use
+        BENCH_HOST("usnprintf_d",
+                   usnprintf(buf, sizeof(buf), (const unsigned char *)"%d", n++ & 63));
+        BENCH_HOST("fmt_i16",
+                   fmt_i16(buf, n++ & 63));
+
+        //The title prompt from the label table, and a countdown numeral at
+        //its normal size and as drawn
+        BENCH_HOST("draw_label_prompt",
+                   drawLabel(LABEL_PUSH_TO_START));
+        BENCH_HOST("draw_label_count",
+                   drawLabel(LABEL_COUNT_3));
+        BENCH_HOST("draw_label_count_scaled",
+                   drawLabelScaled(LABEL_COUNT_3, COUNTDOWN_SCALE));
+    }
+
+    return benchHostEnd();
+}
+
+#endif /* __MSP430__ */
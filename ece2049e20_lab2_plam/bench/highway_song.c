@@ -0,0 +1,137 @@
+/** highway_song.c
+ *
+ *  Created on: Oct 19, 2026
+ *
+ * Plays the shipped song through the PLAY loop on the host and measures
+ * every highway frame: the real session, highway, graphics core and
+ * Sharp128x128 driver, with tools/lcd_host.c in place of the display HAL.
+ * The player holds each note's lanes for its whole length, so the song runs
+ * to the end. Run from the lab directory:
+ *
+ *   gcc -std=gnu99 -O2 -DPROFILE_ENABLE -D__MSP430F5529 -Itools -I. -Igrlib \
+ *       -o highway_song bench/highway_song.c tools/lcd_host.c \
+ *       LcdDriver/sharp128/Sharp128x128.c gfx.c fonts/fontfixed6x8.c \
+ *       utils/profile.c session.c highway.c
+ *   ./highway_song [passes]
+ *
+ * The song is first played once with a flush after the first screen and
+ * after every frame, for the projected on-target bus time of each. It is then played passes
+ * times (default 100) without flushes, timing the main loop's work between
+ * flushes: one sessionTick() per tick and highwayRender() whenever it is
+ * due. The fastest pass is reported, per frame.
+ */
+
+#ifndef __MSP430__
+
+#include "songs.h" //First, so the NULL it defines gives way to the system one
+#include <stdio.h>
+#include <stdlib.h>
+#include "peripherals.h"
+#include "display.h"
+#include "session.h"
+#include "highway.h"
+#include "timebase.h"
+#include "utils/profile.h"
+#include "lcd_host.h"
+
+tContext g_sContext;
+
+static PlaySession session;
+static Highway highway;
+
+//The peripherals the session drives do nothing here, and the frame
+//governor is replaced by flushing each frame as it is drawn
+void configLeds(char button_state) { (void)button_state; }
+void setLaunchpadLeds(char v) { (void)v; }
+void BuzzerOn(int freq) { (void)freq; }
+void BuzzerOff(void) { }
+void displayInvalidate(void) { }
+
+/*
+ * Plays the whole song, flushing the first screen and each frame after it
+ * if flush is set. Returns the number of frames drawn.
+ */
+static unsigned int playSong(int flush, uint32_t *startUs, LcdBusStats *total, uint32_t *maxUs)
+{
+    unsigned long now = 0;
+    unsigned int frames = 0;
+    char buttons;
+    uint32_t us;
+
+    sessionStart(&session, astronomia, ARRAY2_SIZE(astronomia), now);
+    highwayStart(&highway, &session, now);
+    if (flush) {
+        Graphics_flushBuffer(&g_sContext);
+        *startUs = lcdHostProjectUs(&g_lcdBusFrame);
+    }
+    while (session.result.outcome == SESSION_RUNNING) {
+        now++;
+        buttons = (session.note < session.size) ? session.song[session.note].led : 0;
+        sessionTick(&session, now, buttons);
+        if (highwayRender(&highway, now, buttons)) {
+            frames++;
+            if (flush) {
+                Graphics_flushBuffer(&g_sContext);
+                us = lcdHostProjectUs(&g_lcdBusFrame);
+                total->bytes += g_lcdBusFrame.bytes;
+                total->frames += g_lcdBusFrame.frames;
+                total->holdCycles += g_lcdBusFrame.holdCycles;
+                if (us > *maxUs) {
+                    *maxUs = us;
+                }
+            }
+        }
+    }
+    return frames;
+}
+
+int main(int argc, char **argv)
+{
+    static const LcdBusStats zero;
+    LcdBusStats bus = zero;
+    uint32_t startUs = 0;
+    uint32_t maxUs = 0;
+    uint32_t best = UINT32_MAX;
+    unsigned int frames;
+    int passes = (argc > 1) ? atoi(argv[1]) : 100;
+    int i;
+    profileTicks t0, elapsed;
+
+    if (passes < 1) {
+        fprintf(stderr, "usage: %s [passes]\n", argv[0]);
+        return 1;
+    }
+
+    //Same context as configDisplay()
+    Graphics_initContext(&g_sContext, &g_sharp128x128LCD);
+    Graphics_setForegroundColor(&g_sContext, ClrBlack);
+    Graphics_setBackgroundColor(&g_sContext, ClrWhite);
+    Graphics_setFont(&g_sContext, &g_sFontFixed6x8);
+    Graphics_clearDisplay(&g_sContext);
+    Graphics_flushBuffer(&g_sContext);
+
+    lcdHostReset();
+    frames = playSong(1, &startUs, &bus, &maxUs);
+
+    for (i = 0; i < passes; i++) {
+        t0 = PROFILE_NOW();
+        playSong(0, NULL, NULL, NULL);
+        elapsed = PROFILE_NOW() - t0;
+        if (elapsed < best) {
+            best = elapsed;
+        }
+    }
+
+    printf("song: %d notes, %u frames, one every %u ms\n", (int)ARRAY2_SIZE(astronomia),
+           frames, (unsigned int)(HIGHWAY_FRAME_TICKS * TIMEBASE_TICK_MS));
+    printf("bus for the first screen: %lu us\n", (unsigned long)startUs);
+    printf("bus per frame: %lu bytes mean, %lu us mean, %lu us max\n",
+           (unsigned long)(bus.bytes / frames), (unsigned long)(lcdHostProjectUs(&bus) / frames),
+           (unsigned long)maxUs);
+    printf("host per frame: %lu ns (fastest of %d passes)\n",
+           (unsigned long)(((uint64_t)best * 1000000000ULL) / ((uint64_t)PROFILE_TICK_HZ * frames)),
+           passes);
+    return 0;
+}
+
+#endif /* __MSP430__ */
@@ -0,0 +1,76 @@
+/*
+ * clock.c
+ *
+ *  Created on: Oct 19, 2026
+ *
+ * Brings the core voltage up to the level required for MCLK_FREQ_HZ and
+ * locks the DCO to it using the FLL. ACLK is left on its reset source
+ * (XT1, falling back to REFO) so the 32768 Hz timers are unaffected.
+ */
+
+#include <msp430.h>
+#include "clock.h"
+
+/*
+ * Raises the PMM core voltage by exactly one level. The PMM must be stepped
+ * up one level at a time (SLAU208, section 2.2.4).
+ */
+static void setVCoreUp(unsigned int level)
+{
+    PMMCTL0_H = PMMPW_H;                        // Open PMM registers for write
+
+    // Set SVS/SVM high side new level
+    SVSMHCTL = SVSHE | (SVSHRVL0 * level) | SVMHE | (SVSMHRRL0 * level);
+
+    // Set SVM low side to new level and wait for it to settle
+    SVSMLCTL = SVSLE | SVMLE | (SVSMLRRL0 * level);
+    while ((PMMIFG & SVSMLDLYIFG) == 0);
+
+    // Clear already set flags, then set VCore to the new level
+    PMMIFG &= ~(SVMLVLRIFG | SVMLIFG);
+    PMMCTL0_L = PMMCOREV0 * level;
+
+    // Wait until the new level is reached
+    if (PMMIFG & SVMLIFG) {
+        while ((PMMIFG & SVMLVLRIFG) == 0);
+    }
+
+    // Set SVS/SVM low side to the new level
+    SVSMLCTL = SVSLE | (SVSLRVL0 * level) | SVMLE | (SVSMLRRL0 * level);
+
+    PMMCTL0_H = 0x00;                           // Lock PMM registers
+}
+
+/*
+ * Configures MCLK and SMCLK. Must be called before any peripheral whose
+ * timing depends on SMCLK (the LCD SPI port in particular) is initialized.
+ */
+void initClock(void)
+{
+    unsigned int level;
+
+    // Step the core voltage up before raising the frequency
+    for (level = 1; level <= PMM_CORE_LEVEL; level++) {
+        setVCoreUp(level);
+    }
+
+    UCSCTL3 = SELREF__REFOCLK;                  // FLL reference = REFO
+
+    __bis_SR_register(SCG0);                    // Disable the FLL control loop
+    UCSCTL0 = 0x0000;                           // Lowest DCOx and MODx
+    UCSCTL1 = DCO_RANGE;                        // Select DCO range
+    UCSCTL2 = FLLD_1 | FLL_N;                   // DCOCLKDIV = (N + 1) * f_REFO
+    __bic_SR_register(SCG0);                    // Enable the FLL control loop
+
+    __delay_cycles(FLL_SETTLE_CYCLES);
+
+    // Wait for the DCO fault flag to clear
+    do {
+        UCSCTL7 &= ~DCOFFG;
+        SFRIFG1 &= ~OFIFG;
+    } while (UCSCTL7 & DCOFFG);
+
+    // MCLK and SMCLK from DCOCLKDIV; ACLK keeps its reset selection
+    UCSCTL4 = (UCSCTL4 & SELA_7) | SELS__DCOCLKDIV | SELM__DCOCLKDIV;
+    UCSCTL5 = (UCSCTL5 & ~(DIVS_7 | DIVM_7)) | SMCLK_DIVS | DIVM__1;
+}
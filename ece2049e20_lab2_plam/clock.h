@@ -0,0 +1,129 @@
+/*
+ * clock.h
+ *
+ *  Created on: Oct 19, 2026
+ *
+ * Unified Clock System (UCS) configuration. Every frequency-dependent
+ * constant in the project (SPI dividers, LCD chip select hold time, software
+ * delays) is derived from MCLK_FREQ_HZ below, so changing the CPU speed only
+ * requires editing one line.
+ */
+
+#ifndef CLOCK_H_
+#define CLOCK_H_
+
+// ****** CLOCK SELECTION ******
+// MCLK and SMCLK both run from DCOCLKDIV, which the FLL locks to an integer
+// multiple of the 32768 Hz REFO reference. Valid range is 1-25 MHz.
+// tools/check_clock.c builds with other values through -DMCLK_FREQ_HZ.
+#ifndef MCLK_FREQ_HZ
+#define MCLK_FREQ_HZ            16000000UL
+#endif
+
+// SMCLK = MCLK / SMCLK_DIV. Must be one of 1, 2, 4, 8, 16 or 32.
+#define SMCLK_DIV               1
+
+// Frequency of the FLL reference (REFO) and of ACLK
+#define FLL_REF_FREQ_HZ         32768UL
+
+// Frequency the DCO runs at out of reset (DCOCLKDIV = 32 x 32768 Hz).
+// Used to scale loops that were originally tuned at the default speed.
+#define DEFAULT_MCLK_FREQ_HZ    1048576UL
+
+// The Sharp memory LCD accepts SCLK up to 1.1 MHz
+#define LCD_SPI_FREQ_HZ         1000000UL
+
+//*****************************************************************************
+// Derived constants. Do not edit below this line.
+//*****************************************************************************
+
+#define SMCLK_FREQ_HZ           (MCLK_FREQ_HZ / SMCLK_DIV)
+
+// FLL multiplier: DCOCLKDIV = (FLL_N + 1) * FLL_REF_FREQ_HZ
+#define FLL_N                   ((MCLK_FREQ_HZ / FLL_REF_FREQ_HZ) - 1)
+
+// DCO range select. DCOCLK runs at twice MCLK since FLLD = 2.
+#if MCLK_FREQ_HZ <= 16000000UL
+#define DCO_RANGE               DCORSEL_5
+#else
+#define DCO_RANGE               DCORSEL_7
+#endif
+
+// PMM core voltage level required for MCLK (datasheet SLAS590, table 5.3)
+#if MCLK_FREQ_HZ <= 8000000UL
+#define PMM_CORE_LEVEL          0
+#elif MCLK_FREQ_HZ <= 12000000UL
+#define PMM_CORE_LEVEL          1
+#elif MCLK_FREQ_HZ <= 20000000UL
+#define PMM_CORE_LEVEL          2
+#else
+#define PMM_CORE_LEVEL          3
+#endif
+
+// SMCLK divider register field
+#if SMCLK_DIV == 1
+#define SMCLK_DIVS              DIVS__1
+#elif SMCLK_DIV == 2
+#define SMCLK_DIVS              DIVS__2
+#elif SMCLK_DIV == 4
+#define SMCLK_DIVS              DIVS__4
+#elif SMCLK_DIV == 8
+#define SMCLK_DIVS              DIVS__8
+#elif SMCLK_DIV == 16
+#define SMCLK_DIVS              DIVS__16
+#elif SMCLK_DIV == 32
+#define SMCLK_DIVS              DIVS__32
+#endif
+
+// Worst case FLL settling time: 32 x 32 x f_MCLK / f_FLL_reference cycles
+#define FLL_SETTLE_CYCLES       (32UL * 32UL * (MCLK_FREQ_HZ / FLL_REF_FREQ_HZ))
+
+// UCSI bit rate divider for the LCD. The UCBRx register divides SMCLK
+// directly, so round up to stay at or below LCD_SPI_FREQ_HZ.
+#define LCD_SPI_CLK_TICKS       ((SMCLK_FREQ_HZ + LCD_SPI_FREQ_HZ - 1) / LCD_SPI_FREQ_HZ)
+#define LCD_SPI_ACTUAL_FREQ_HZ  (SMCLK_FREQ_HZ / LCD_SPI_CLK_TICKS)
+
+// MCLK cycles per microsecond, rounded up so delays are never short
+#define MCLK_CYCLES_PER_US      ((MCLK_FREQ_HZ + 999999UL) / 1000000UL)
+
+// Sharp LCD thSCS: chip select must stay high >= 2 us after the last bit
+#define LCD_CS_HOLD_CYCLES      (2UL * MCLK_CYCLES_PER_US)
+
+// swDelay() loops were tuned at the reset clock; scale them by this factor
+#define SWDELAY_SCALE           ((MCLK_FREQ_HZ + DEFAULT_MCLK_FREQ_HZ / 2) / DEFAULT_MCLK_FREQ_HZ)
+
+//*****************************************************************************
+// Sanity checks on the derived constants
+//*****************************************************************************
+#if (MCLK_FREQ_HZ < 1000000UL) || (MCLK_FREQ_HZ > 25000000UL)
+#error "MCLK_FREQ_HZ must be between 1 MHz and 25 MHz"
+#endif
+
+#if (MCLK_FREQ_HZ % FLL_REF_FREQ_HZ) > (FLL_REF_FREQ_HZ / 2)
+#warning "MCLK_FREQ_HZ is not close to a multiple of the FLL reference; actual MCLK will be lower"
+#endif
+
+#if FLL_N > 1023
+#error "FLL_N does not fit in the 10-bit FLLN field"
+#endif
+
+#ifndef SMCLK_DIVS
+#error "SMCLK_DIV must be one of 1, 2, 4, 8, 16 or 32"
+#endif
+
+#if LCD_SPI_CLK_TICKS > 0xFFFF
+#error "LCD SPI divider does not fit in UCB0BRW"
+#endif
+
+#if LCD_SPI_ACTUAL_FREQ_HZ > LCD_SPI_FREQ_HZ
+#error "LCD SPI clock exceeds LCD_SPI_FREQ_HZ"
+#endif
+
+#if SWDELAY_SCALE < 1
+#error "SWDELAY_SCALE must be at least 1"
+#endif
+
+// Prototypes for functions implemented in clock.c
+void initClock(void);
+
+#endif /* CLOCK_H_ */
@@ -0,0 +1,113 @@
+/** debounce.c
+ *
+ *  Created on: Oct 19, 2026
+ *
+ * Vertical counter debouncer. See debounce.h.
+ */
+
+#include <msp430.h>
+#include "debounce.h"
+
+static volatile uint8_t state; //Debounced buttons, 1 = pressed
+static uint8_t cnt0 = 0xFF; //Low and high bits of the per-button counters;
+static uint8_t cnt1 = 0xFF; //all ones while a button agrees with state
+static uint16_t held; //Ticks the current set of held buttons has been held
+static volatile DebounceEvents pending;
+
+#ifdef TIMEBASE_TICKLESS
+static uint16_t lastTick;
+
+/*
+ * Samples once if the tick moved since the last call; there is no tick
+ * interrupt to do it
+ */
+static void poll(void)
+{
+    uint16_t now = timebaseNow16();
+
+    if (now != lastTick) {
+        lastTick = now;
+        debounceTick();
+    }
+}
+#else
+#define poll()  do {} while (0)
+#endif
+
+/*
+ * Forgets the buttons' state and any events not yet taken
+ */
+void debounceInit(void)
+{
+    unsigned short sr = __get_SR_register();
+
+    __disable_interrupt();
+    state = 0;
+    cnt0 = 0xFF;
+    cnt1 = 0xFF;
+    held = 0;
+    pending.pressed = 0;
+    pending.released = 0;
+    pending.longPress = 0;
+    pending.repeat = 0;
+    if (sr & GIE) {
+        __enable_interrupt();
+    }
+}
+
+/*
+ * Samples the buttons once. Called every tick by the timebase interrupt.
+ */
+void debounceTick(void)
+{
+    uint8_t changed = state ^ debounceRead(); //Buttons that disagree with state
+
+    //Count down where they disagree, back to all ones where they agree
+    cnt0 = ~(cnt0 & changed);
+    cnt1 = cnt0 ^ (cnt1 & changed);
+    changed &= cnt0 & cnt1; //Counters that wrapped: DEBOUNCE_SAMPLES ticks in a row
+    state ^= changed;
+
+    pending.pressed |= changed & state;
+    pending.released |= changed & ~state;
+
+    if (changed || (state == 0)) {
+        held = 0;
+    } else if (++held == DEBOUNCE_LONG_TICKS) {
+        pending.longPress |= state;
+    } else if (held == DEBOUNCE_LONG_TICKS + DEBOUNCE_REPEAT_TICKS) {
+        pending.repeat |= state;
+        held = DEBOUNCE_LONG_TICKS;
+    }
+}
+
+/*
+ * Returns the debounced buttons, 1 = pressed
+ */
+uint8_t debounceState(void)
+{
+    poll();
+    return state;
+}
+
+/*
+ * Copies the events collected since the last call into events and clears them
+ */
+void debounceTake(DebounceEvents *events)
+{
+    unsigned short sr = __get_SR_register();
+
+    poll();
+    __disable_interrupt();
+    events->pressed = pending.pressed;
+    events->released = pending.released;
+    events->longPress = pending.longPress;
+    events->repeat = pending.repeat;
+    pending.pressed = 0;
+    pending.released = 0;
+    pending.longPress = 0;
+    pending.repeat = 0;
+    if (sr & GIE) {
+        __enable_interrupt();
+    }
+}
@@ -0,0 +1,58 @@
+/** debounce.h
+ *
+ *  Created on: Oct 19, 2026
+ *
+ * Debouncer for up to 8 buttons, run from the timebase tick. Each lab
+ * reads its raw buttons in debounceRead(), one bit per button, 1 = pressed.
+ *
+ * Every input has a 2-bit counter, but the counters are stored vertically:
+ * bit n of cnt0 and cnt1 is the counter of input n. One tick updates all 8
+ * counters with a handful of byte-wide logic operations, so the cost does
+ * not depend on how many buttons there are. A counter is reset whenever
+ * the raw input agrees with the debounced state, so the state only changes
+ * after DEBOUNCE_SAMPLES ticks in a row that disagree with it.
+ *
+ * Events are collected until debounceTake() takes them:
+ *
+ *  - pressed, released: the debounced state went to 1 or to 0
+ *  - longPress: the buttons held have not changed for DEBOUNCE_LONG_MS
+ *  - repeat: every DEBOUNCE_REPEAT_MS after the long press while they
+ *    stay held
+ *
+ * Long presses and repeats share one hold timer for all buttons, which
+ * restarts whenever any button changes. That keeps them O(1) too.
+ *
+ * debounceState() is the debounced level, for code that acts while a
+ * button is held. In TIMEBASE_TICKLESS builds there is no tick interrupt,
+ * so debounceState() and debounceTake() sample once whenever the tick has
+ * moved since they last ran.
+ */
+
+#ifndef DEBOUNCE_H_
+#define DEBOUNCE_H_
+
+#include <stdint.h>
+#include "timebase.h"
+
+#define DEBOUNCE_SAMPLES        4   // Set by the 2-bit counters
+#define DEBOUNCE_LONG_MS        500
+#define DEBOUNCE_REPEAT_MS      150
+
+#define DEBOUNCE_LONG_TICKS     (DEBOUNCE_LONG_MS / TIMEBASE_TICK_MS)
+#define DEBOUNCE_REPEAT_TICKS   (DEBOUNCE_REPEAT_MS / TIMEBASE_TICK_MS)
+
+typedef struct {
+    uint8_t pressed;
+    uint8_t released;
+    uint8_t longPress;
+    uint8_t repeat;
+} DebounceEvents;
+
+uint8_t debounceRead(void); // Raw buttons, implemented by each lab in peripherals.c
+
+void debounceInit(void);
+void debounceTick(void);
+uint8_t debounceState(void);
+void debounceTake(DebounceEvents *events);
+
+#endif /* DEBOUNCE_H_ */
@@ -0,0 +1,121 @@
+/** display.c
+ *
+ *  Created on: Oct 19, 2026
+ *
+ * Frame pacing and VCOM timer for the LCD. See display.h.
+ */
+
+#include <msp430.h>
+#include "peripherals.h"
+#include "display.h"
+#include "utils/profile.h"
+
+// Timer A1 runs from ACLK / 8
+#define DISPLAY_TIMER_HZ        (32768 / 8)
+#define DISPLAY_FRAME_COUNTS    (DISPLAY_TIMER_HZ / DISPLAY_FRAME_HZ)
+#define VCOM_FRAMES             (DISPLAY_FRAME_HZ / VCOM_TIMER_HZ)
+
+#if VCOM_FRAMES < 1
+#error "DISPLAY_FRAME_HZ must be at least VCOM_TIMER_HZ"
+#endif
+
+DisplayStats g_displayStats;
+
+static volatile uint8_t frameDue = 1; // A frame boundary passed since the last flush
+static volatile uint8_t dirty = 0; // Frame buffer changed since the last flush
+static uint8_t vcomCount = 0;
+
+/*
+ * Starts the frame timer: ACLK / 8, up mode, DISPLAY_FRAME_HZ interrupts
+ * per second. Needs GIE.
+ */
+void displayInit(void)
+{
+    g_displayStats.requested = 0;
+    g_displayStats.performed = 0;
+
+    TA1CTL = TASSEL_1 | ID_3 | MC_1 | TACLR;
+    TA1CCR0 = DISPLAY_FRAME_COUNTS - 1;
+    TA1CCTL0 = CCIE;
+}
+
+/*
+ * Marks the frame buffer as changed. The flush happens in displayService().
+ */
+void displayInvalidate(void)
+{
+    g_displayStats.requested++;
+    dirty = 1;
+}
+
+/*
+ * Sends the frame buffer if it changed and a frame boundary has passed
+ * since the last flush. Cheap to call when there is nothing to do. With the
+ * double-buffered Sharp128x128 driver a frame still on the bus also defers
+ * the flush, so the caller never waits for the SPI.
+ */
+void displayService(void)
+{
+#if defined(DISPLAY_SHARP128x128)
+    if (Sharp128x128_isFlushBusy()) {
+        return;
+    }
+#endif
+    if (dirty && frameDue) {
+        frameDue = 0;
+        dirty = 0;
+        g_displayStats.performed++;
+        Graphics_flushBuffer(&g_sContext);
+    }
+}
+
+/*
+ * Marks the frame buffer as changed and does not return until it has been
+ * sent, waiting for the frame boundary if one has not passed yet
+ */
+void displayPresent(void)
+{
+    displayInvalidate();
+    while (dirty) {
+        displayService();
+    }
+}
+
+/*
+ * Writes the flush requests and the flushes performed since the last dump
+ * to the UART, then clears both (PROFILE_ENABLE only)
+ */
+void displayDumpUart(void)
+{
+#ifdef PROFILE_ENABLE
+    char num[12];
+
+    profileUartPuts("flushes requested ");
+    profileFormatU32(num, g_displayStats.requested, 0);
+    profileUartPuts(num);
+    profileUartPuts(" performed ");
+    profileFormatU32(num, g_displayStats.performed, 0);
+    profileUartPuts(num);
+    profileUartPuts("\r\n");
+    g_displayStats.requested = 0;
+    g_displayStats.performed = 0;
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Timer1 A0 Interrupt Service Routine
+//------------------------------------------------------------------------------
+#pragma vector=TIMER1_A0_VECTOR
+__interrupt void TIMER1_A0_ISR (void)
+{
+    frameDue = 1;
+
+    if (++vcomCount >= VCOM_FRAMES) {
+        vcomCount = 0;
+#if defined(DISPLAY_SHARP96x96)
+        Sharp96x96_SendToggleVCOMCommand();  // display needs this toggle < 1 per sec
+#elif defined(DISPLAY_SHARP128x128)
+        Sharp128x128_SendToggleVCOMCommand(); // rides on the next flush; only sent on its own when the screen is idle
+#endif
+    }
+}
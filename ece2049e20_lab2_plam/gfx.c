@@ -0,0 +1,581 @@
+/** gfx.c
+ *
+ *  Created on: Oct 19, 2026
+ *
+ * In-tree graphics core on top of the Sharp128x128 driver. See gfx.h.
+ *
+ * The code is placed in .text:gfx so the linker can report its size
+ * (gfxTextSize, see lnk_msp430f5529.cmd) next to the benchmark results.
+ */
+
+#include <string.h>
+#include "peripherals.h"
+#include "gfx.h"
+
+#ifdef GFX_CORE
+
+#pragma SET_CODE_SECTION(".text:gfx")
+
+// Frame buffer bytes for a translated color: a pixel drawn in it becomes
+// (pixel & KEEP) ^ FLIP, so ClrInvert toggles pixels and the others set them
+#define FLIP(color)     ((color) ? 0xFF : 0x00)
+#define KEEP(color)     (((color) == SHARP_COLOR_INVERT) ? 0xFF : 0x00)
+
+/*
+ * Sets bits x1 to x2 of rows y1 to y2 to fill (0x00 or 0xFF), or toggles
+ * them where keep is 0xFF, without marking them. The area must already be
+ * clipped.
+ */
+static void fillRows(int16_t x1, int16_t x2, int16_t y1, int16_t y2, uint8_t fill, uint8_t keep)
+{
+    uint8_t first = 0xFF >> (x1 & 0x7);
+    uint8_t last = 0xFF << (7 - (x2 & 0x7));
+    int16_t i1 = x1 >> 3;
+    int16_t i2 = x2 >> 3;
+    int16_t i;
+    uint8_t *row;
+
+    if (i1 == i2) { //Both edges are in one byte
+        first &= last;
+    }
+
+    for (; y1 <= y2; y1++) {
+        row = Sharp128x128_row(y1);
+        row[i1] = (row[i1] & (~first | keep)) ^ (fill & first);
+        if (i2 > i1) {
+            for (i = i1 + 1; i < i2; i++) {
+                row[i] = (row[i] & keep) ^ fill;
+            }
+            row[i2] = (row[i2] & (~last | keep)) ^ (fill & last);
+        }
+    }
+}
+
+/*
+ * Draws bits x1 to x2 of rows y1 to y2 in a translated color. The area
+ * must already be clipped.
+ */
+static void fillSpan(int16_t x1, int16_t x2, int16_t y1, int16_t y2, uint16_t color)
+{
+    Sharp128x128_markSpan(x1, x2, y1, y2);
+    fillRows(x1, x2, y1, y2, FLIP(color), KEEP(color));
+}
+
+/*
+ * Returns the glyph of c: a size byte, a width byte, then width bits per
+ * row, rows packed back to back starting at the MSB. Characters the font
+ * has no glyph for are drawn as a period, like grlib does.
+ */
+static const uint8_t *glyph(const Graphics_Font *font, uint8_t c)
+{
+    if ((c < ' ') || (c > '~')) {
+        c = '.';
+    }
+    return font->data + font->offset[c - ' '];
+}
+
+/*
+ * Sets up a context for display with the whole screen as clip region
+ */
+void gfxInitContext(Graphics_Context *context, const Graphics_Display *display)
+{
+    context->size = sizeof(Graphics_Context);
+    context->display = display;
+    context->clipRegion.xMin = 0;
+    context->clipRegion.yMin = 0;
+    context->clipRegion.xMax = display->width - 1;
+    context->clipRegion.yMax = display->heigth - 1;
+    context->foreground = 0;
+    context->background = 0;
+    context->font = 0;
+}
+
+/*
+ * Clears the screen and the frame buffer to the background color
+ */
+void gfxClearDisplay(const Graphics_Context *context)
+{
+    Sharp128x128_clearDisplay(context->background);
+}
+
+/*
+ * Sends the frame buffer to the screen
+ */
+void gfxFlushBuffer(const Graphics_Context *context)
+{
+    Sharp128x128_flushBuffer();
+}
+
+/*
+ * Fills rect, edges included, with the foreground color
+ */
+void gfxFillRectangle(const Graphics_Context *context, const Graphics_Rectangle *rect)
+{
+    const Graphics_Rectangle *clip = &context->clipRegion;
+    int16_t x1 = rect->xMin, x2 = rect->xMax;
+    int16_t y1 = rect->yMin, y2 = rect->yMax;
+    int16_t t;
+
+    if (x1 > x2) {
+        t = x1; x1 = x2; x2 = t;
+    }
+    if (y1 > y2) {
+        t = y1; y1 = y2; y2 = t;
+    }
+    if (x1 < clip->xMin) x1 = clip->xMin;
+    if (x2 > clip->xMax) x2 = clip->xMax;
+    if (y1 < clip->yMin) y1 = clip->yMin;
+    if (y2 > clip->yMax) y2 = clip->yMax;
+
+    if ((x1 <= x2) && (y1 <= y2)) {
+        fillSpan(x1, x2, y1, y2, context->foreground);
+    }
+}
+
+/*
+ * Draws a horizontal line from x1 to x2, both included, in the foreground
+ * color
+ */
+void gfxDrawLineH(const Graphics_Context *context, int32_t x1, int32_t x2, int32_t y)
+{
+    const Graphics_Rectangle *clip = &context->clipRegion;
+    int32_t t;
+
+    if (x1 > x2) {
+        t = x1; x1 = x2; x2 = t;
+    }
+    if ((y < clip->yMin) || (y > clip->yMax)) {
+        return;
+    }
+    if (x1 < clip->xMin) x1 = clip->xMin;
+    if (x2 > clip->xMax) x2 = clip->xMax;
+
+    if (x1 <= x2) {
+        fillSpan(x1, x2, y, y, context->foreground);
+    }
+}
+
+/*
+ * Returns the width in pixels of the first length characters of string,
+ * or all of it for AUTO_STRING_LENGTH
+ */
+int32_t gfxGetStringWidth(const Graphics_Context *context, const uint8_t *string, int32_t length)
+{
+    int32_t width = 0;
+
+    while (length-- && *string) {
+        width += glyph(context->font, *string++)[1];
+    }
+    return width;
+}
+
+/*
+ * Draws the first length characters of string, or all of it for
+ * AUTO_STRING_LENGTH, with the top left corner of the first character cell
+ * at x, y. Text is drawn in the foreground color; with opaque the rest of
+ * each character cell is set to the background color.
+ */
+void gfxDrawString(const Graphics_Context *context, const uint8_t *string, int32_t length,
+                   int32_t x, int32_t y, bool opaque)
+{
+    const Graphics_Rectangle *clip = &context->clipRegion;
+    const Graphics_Font *font = context->font;
+    uint16_t fg = FLIP(context->foreground) * 0x0101U;
+    uint16_t bg = FLIP(context->background) * 0x0101U;
+    uint16_t fgKeep = KEEP(context->foreground) * 0x0101U;
+    uint16_t bgKeep = KEEP(context->background) * 0x0101U;
+    int16_t cx = x;
+    int16_t cy = y;
+    int16_t first, r, r0, r1;
+
+    //Rows of the cell that are inside the clip region
+    r0 = (cy < clip->yMin) ? clip->yMin - cy : 0;
+    r1 = (cy + font->height - 1 > clip->yMax) ? clip->yMax - cy : font->height - 1;
+    if (r0 > r1) {
+        return;
+    }
+
+    first = (cx > clip->xMin) ? cx : clip->xMin;
+
+    while (length-- && *string && (cx <= clip->xMax)) {
+        const uint8_t *data = glyph(font, *string++);
+        uint8_t width = data[1];
+        int16_t i = cx >> 3;
+        uint8_t shift = cx & 0x7;
+        uint8_t cols = 0xFF << (8 - width);
+        uint16_t cell;
+
+        if (cx + width <= clip->xMin) { //Entirely left of the clip region
+            cx += width;
+            continue;
+        }
+        if (cx < clip->xMin) {
+            cols &= 0xFF >> (clip->xMin - cx);
+        }
+        if (cx + 7 > clip->xMax) {
+            cols &= 0xFF << (cx + 7 - clip->xMax);
+        }
+        cell = (uint16_t)cols << (8 - shift);
+
+        for (r = r0; r <= r1; r++) {
+            uint8_t bit = r * width;
+            uint8_t pixels = data[2 + (bit >> 3)] << (bit & 0x7);
+            uint16_t ink, mask, value, clear;
+            uint8_t *row;
+
+            if ((bit & 0x7) + width > 8) { //Row continues in the next byte
+                pixels |= data[3 + (bit >> 3)] >> (8 - (bit & 0x7));
+            }
+            ink = (uint16_t)(pixels & cols) << (8 - shift);
+            mask = opaque ? cell : ink;
+            value = ((ink & fg) | (~ink & bg)) & mask;
+            clear = mask & ~((ink & fgKeep) | (~ink & bgKeep)); //Bits that are not toggled
+
+            //Only touch bytes that have pixels inside the clip region, so
+            //cells hanging off either edge of the screen stay in the row
+            row = Sharp128x128_row(cy + r);
+            if (mask >> 8) {
+                row[i] = (row[i] & ~(clear >> 8)) ^ (value >> 8);
+            }
+            if (mask & 0xFF) {
+                row[i + 1] = (row[i + 1] & ~clear) ^ value;
+            }
+        }
+        cx += width;
+    }
+
+    if (cx > first) {
+        Sharp128x128_markSpan(first, (cx - 1 < clip->xMax) ? cx - 1 : clip->xMax,
+                              cy + r0, cy + r1);
+    }
+}
+
+/*
+ * Draws string centered horizontally on x, with the middle of the
+ * baseline-to-top part of the cell on y, as grlib does
+ */
+void gfxDrawStringCentered(const Graphics_Context *context, const uint8_t *string, int32_t length,
+                           int32_t x, int32_t y, bool opaque)
+{
+    gfxDrawString(context, string, length,
+                  x - (gfxGetStringWidth(context, string, length) / 2),
+                  y - (context->font->baseline / 2), opaque);
+}
+
+/*
+ * The bits of a nibble with each bit repeated scale times, MSB first,
+ * indexed by scale - 1
+ */
+static const uint16_t spread[GFX_SCALE_MAX][16] = {
+    {0x0, 0x1, 0x2, 0x3, 0x4, 0x5, 0x6, 0x7, 0x8, 0x9, 0xA, 0xB, 0xC, 0xD, 0xE, 0xF},
+    {0x00, 0x03, 0x0C, 0x0F, 0x30, 0x33, 0x3C, 0x3F, 0xC0, 0xC3, 0xCC, 0xCF, 0xF0, 0xF3, 0xFC, 0xFF},
+    {0x000, 0x007, 0x038, 0x03F, 0x1C0, 0x1C7, 0x1F8, 0x1FF,
+     0xE00, 0xE07, 0xE38, 0xE3F, 0xFC0, 0xFC7, 0xFF8, 0xFFF},
+    {0x0000, 0x000F, 0x00F0, 0x00FF, 0x0F00, 0x0F0F, 0x0FF0, 0x0FFF,
+     0xF000, 0xF00F, 0xF0F0, 0xF0FF, 0xFF00, 0xFF0F, 0xFFF0, 0xFFFF}
+};
+
+/*
+ * Draws the first length characters of string, or all of it for
+ * AUTO_STRING_LENGTH, scale (1 to GFX_SCALE_MAX) times larger with the top
+ * left corner of the first character cell at x, y. Each glyph row is
+ * widened a nibble at a time through spread[], shifted to x once and then
+ * written to scale rows of the frame buffer, so a scaled glyph costs about
+ * as much as the frame buffer bytes it covers.
+ */
+void gfxDrawStringScaled(const Graphics_Context *context, const uint8_t *string, int32_t length,
+                         int32_t x, int32_t y, uint8_t scale, bool opaque)
+{
+    const Graphics_Rectangle *clip = &context->clipRegion;
+    const Graphics_Font *font = context->font;
+    const uint16_t *lut;
+    uint8_t fg = FLIP(context->foreground);
+    uint8_t bg = FLIP(context->background);
+    uint8_t fgKeep = KEEP(context->foreground);
+    uint8_t bgKeep = KEEP(context->background);
+    uint8_t cols[GFX_SCALE_MAX + 1]; //Bytes of the cell, clipped
+    uint8_t clear[GFX_SCALE_MAX + 1];
+    uint8_t value[GFX_SCALE_MAX + 1];
+    int16_t cx = x;
+    int16_t cy = y;
+    int16_t first, r0, r1;
+
+    if (scale < 1) {
+        scale = 1;
+    } else if (scale > GFX_SCALE_MAX) {
+        scale = GFX_SCALE_MAX;
+    }
+    lut = spread[scale - 1];
+
+    //Rows of the scaled cell that are inside the clip region
+    r0 = (cy < clip->yMin) ? clip->yMin - cy : 0;
+    r1 = (cy + font->height * scale - 1 > clip->yMax) ? clip->yMax - cy : font->height * scale - 1;
+    if (r0 > r1) {
+        return;
+    }
+
+    first = (cx > clip->xMin) ? cx : clip->xMin;
+
+    while (length-- && *string && (cx <= clip->xMax)) {
+        const uint8_t *data = glyph(font, *string++);
+        uint8_t width = data[1];
+        int16_t w = width * scale;
+        int16_t i = cx >> 3;
+        uint8_t shift = cx & 0x7;
+        int16_t n = (shift + w + 7) >> 3; //Frame buffer bytes the cell touches
+        int16_t a = (cx > clip->xMin) ? cx : clip->xMin;
+        int16_t b = (cx + w - 1 < clip->xMax) ? cx + w - 1 : clip->xMax;
+        int16_t k, r, sr;
+
+        if (a > b) { //Entirely left of the clip region
+            cx += w;
+            continue;
+        }
+        for (k = 0; k < n; k++) {
+            int16_t lo = a - (i + k) * 8;
+            int16_t hi = b - (i + k) * 8;
+
+            lo = (lo > 0) ? lo : 0;
+            hi = (hi < 7) ? hi : 7;
+            cols[k] = (lo > hi) ? 0 : ((0xFF >> lo) & (0xFF << (7 - hi)));
+        }
+
+        for (sr = r0 / scale; sr <= r1 / scale; sr++) {
+            uint8_t bit = sr * width;
+            uint8_t pixels = data[2 + (bit >> 3)] << (bit & 0x7);
+            uint32_t wide;
+            uint8_t carry = 0;
+
+            if ((bit & 0x7) + width > 8) { //Row continues in the next byte
+                pixels |= data[3 + (bit >> 3)] >> (8 - (bit & 0x7));
+            }
+            pixels &= 0xFF << (8 - width);
+
+            //scale bits per pixel, MSB leftmost, then shifted to x
+            wide = ((uint32_t)lut[pixels >> 4] << (scale << 2)) | lut[pixels & 0xF];
+            wide <<= 32 - (scale << 3);
+            for (k = 0; k < n; k++) {
+                uint8_t bits = (k < scale) ? (uint8_t)(wide >> (24 - (k << 3))) : 0;
+                uint8_t ink = carry | (bits >> shift);
+                uint8_t mask = (opaque ? 0xFF : ink) & cols[k];
+
+                carry = bits << (8 - shift);
+                value[k] = ((ink & fg) | (~ink & bg)) & mask;
+                clear[k] = mask & ~((ink & fgKeep) | (~ink & bgKeep));
+            }
+
+            for (r = (sr * scale > r0) ? sr * scale : r0; (r < (sr + 1) * scale) && (r <= r1); r++) {
+                uint8_t *row = Sharp128x128_row(cy + r);
+
+                for (k = 0; k < n; k++) {
+                    if (clear[k] | value[k]) { //Only bytes inside the clip region
+                        row[i + k] = (row[i + k] & ~clear[k]) ^ value[k];
+                    }
+                }
+            }
+        }
+        cx += w;
+    }
+
+    if (cx > first) {
+        Sharp128x128_markSpan(first, (cx - 1 < clip->xMax) ? cx - 1 : clip->xMax,
+                              cy + r0, cy + r1);
+    }
+}
+
+/*
+ * gfxDrawStringCentered() for text drawn scale times larger
+ */
+void gfxDrawStringScaledCentered(const Graphics_Context *context, const uint8_t *string,
+                                 int32_t length, int32_t x, int32_t y, uint8_t scale, bool opaque)
+{
+    gfxDrawStringScaled(context, string, length,
+                        x - (gfxGetStringWidth(context, string, length) * scale / 2),
+                        y - (context->font->baseline * scale / 2), scale, opaque);
+}
+
+/*
+ * Copies a full screen image over the frame buffer. image holds
+ * LCD_VERTICAL_MAX rows of LCD_HORIZONTAL_MAX / 8 bytes, top row first,
+ * MSB leftmost and set bits white, as the frame buffer does.
+ */
+void gfxBlitScreen(const uint8_t *image)
+{
+    int16_t y;
+
+    for (y = 0; y < LCD_VERTICAL_MAX; y++) {
+        memcpy(Sharp128x128_row(y), image, LCD_HORIZONTAL_MAX / 8);
+        image += LCD_HORIZONTAL_MAX / 8;
+    }
+    Sharp128x128_markSpan(0, LCD_HORIZONTAL_MAX - 1, 0, LCD_VERTICAL_MAX - 1);
+}
+
+/*
+ * Draws image with its top left corner at x, y, clipped to the clip region.
+ * Only IMAGE_FMT_1BPP_UNCOMP is supported, the format of the images in
+ * images/; other images are not drawn. A palette color other than black is
+ * white. Each row is copied with Sharp128x128_blitRow(), which shifts it into
+ * place at any x, and the whole area is marked once.
+ */
+void gfxDrawImage(const Graphics_Context *context, const Graphics_Image *image,
+                  int16_t x, int16_t y)
+{
+    const Graphics_Rectangle *clip = &context->clipRegion;
+    int16_t stride = (image->xSize + 7) >> 3;
+    int16_t x1 = x, x2 = x + image->xSize - 1;
+    int16_t y1 = y, y2 = y + image->ySize - 1;
+    uint8_t fore = image->pPalette[1] ? 0xFF : 0x00;
+    uint8_t back = image->pPalette[0] ? 0xFF : 0x00;
+    const uint8_t *data;
+    int16_t r;
+
+    if (image->bPP != IMAGE_FMT_1BPP_UNCOMP) {
+        return;
+    }
+    if (x1 < clip->xMin) x1 = clip->xMin;
+    if (x2 > clip->xMax) x2 = clip->xMax;
+    if (y1 < clip->yMin) y1 = clip->yMin;
+    if (y2 > clip->yMax) y2 = clip->yMax;
+    if ((x1 > x2) || (y1 > y2)) {
+        return;
+    }
+
+    data = image->pPixel + (y1 - y) * stride + ((x1 - x) >> 3);
+    for (r = y1; r <= y2; r++) {
+        Sharp128x128_blitRow(x1, r, (x1 - x) & 0x7, x2 - x1 + 1, data, fore, back);
+        data += stride;
+    }
+    Sharp128x128_markSpan(x1, x2, y1, y2);
+}
+
+/*
+ * Draws image columns a to b of one asset row at x, y. The columns lie in
+ * bytes col onwards of a PackBits run: run points at the byte for col in a
+ * literal run, or at the byte that is repeated.
+ */
+static void drawAssetRun(int16_t x, int16_t y, int16_t a, int16_t b, int16_t col,
+                         const uint8_t *run, bool repeat, uint8_t fore, uint8_t back)
+{
+    int16_t end;
+
+    if (!repeat) { //The row is in flash as it is
+        Sharp128x128_blitRow(x + a, y, a & 0x7, b - a + 1, run + (a >> 3) - col, fore, back);
+    } else if ((*run == 0x00) || (*run == 0xFF)) {
+        fillRows(x + a, x + b, y, y, *run ? fore : back, 0x00);
+    } else { //A pattern, one byte at a time from the single copy
+        for (; a <= b; a = end + 1) {
+            end = (a | 0x7) < b ? (a | 0x7) : b;
+            Sharp128x128_blitRow(x + a, y, a & 0x7, end - a + 1, run, fore, back);
+        }
+    }
+}
+
+/*
+ * Draws asset with its top left corner at x, y, clipped to the clip region.
+ * Set bits are drawn in the foreground color and clear bits in the
+ * background color.
+ *
+ * The data is a PackBits stream of the rows, top row first, rows padded to
+ * whole bytes, runs free to cross row ends. A control byte c of 0 to 127 is
+ * followed by c + 1 literal bytes; 128 to 255 by one byte repeated c - 126
+ * times. Runs are decoded straight into the frame buffer: literal bytes are
+ * shifted into place from flash, repeated 0x00 or 0xFF bytes become fills,
+ * and no row is ever built in RAM. Rows below the clip region are not
+ * decoded.
+ */
+void gfxDrawAsset(const Graphics_Context *context, const GfxAsset *asset,
+                  int16_t x, int16_t y)
+{
+    const Graphics_Rectangle *clip = &context->clipRegion;
+    const uint8_t *data = asset->data;
+    const uint8_t *end = data + asset->size;
+    int16_t stride = GFX_ASSET_STRIDE(asset);
+    uint8_t fore = context->foreground ? 0xFF : 0x00;
+    uint8_t back = context->background ? 0xFF : 0x00;
+    int16_t a1, a2, r1, r2; //Columns and rows of the asset inside the clip region
+    int16_t col = 0, row = 0;
+
+    a1 = (clip->xMin > x) ? clip->xMin - x : 0;
+    a2 = (clip->xMax < x + (int16_t)asset->width - 1) ? clip->xMax - x : asset->width - 1;
+    r1 = (clip->yMin > y) ? clip->yMin - y : 0;
+    r2 = (clip->yMax < y + (int16_t)asset->height - 1) ? clip->yMax - y : asset->height - 1;
+    if ((a1 > a2) || (r1 > r2)) {
+        return;
+    }
+
+    while ((data < end) && (row <= r2)) {
+        uint8_t control = *data++;
+        const uint8_t *run = data;
+        bool repeat = (control & 0x80) != 0;
+        int16_t n = repeat ? control - 126 : control + 1;
+
+        data += repeat ? 1 : n;
+
+        while ((n > 0) && (row <= r2)) {
+            int16_t k = (stride - col < n) ? stride - col : n; //Bytes in this row
+            int16_t a = (col << 3 > a1) ? col << 3 : a1;
+            int16_t b = (((col + k) << 3) - 1 < a2) ? ((col + k) << 3) - 1 : a2;
+
+            if ((row >= r1) && (a <= b)) {
+                drawAssetRun(x, y + row, a, b, col, run, repeat, fore, back);
+            }
+            if (!repeat) {
+                run += k;
+            }
+            n -= k;
+            col += k;
+            if (col == stride) {
+                col = 0;
+                row++;
+            }
+        }
+    }
+    Sharp128x128_markSpan(x + a1, x + a2, y + r1, y + r2);
+}
+
+/*
+ * Draws a sprite of height rows of stride bytes with its top left corner at
+ * x, y. x must be a multiple of 8. Inside mask, set ink bits are drawn in
+ * the foreground color and clear ones in the background color; pixels
+ * outside mask are left as they are. Rows and whole bytes outside the clip
+ * region are skipped.
+ */
+void gfxDrawSprite(const Graphics_Context *context, const uint8_t *ink, const uint8_t *mask,
+                   int16_t stride, int16_t height, int16_t x, int16_t y)
+{
+    const Graphics_Rectangle *clip = &context->clipRegion;
+    uint8_t fore = context->foreground ? 0xFF : 0x00;
+    uint8_t back = context->background ? 0xFF : 0x00;
+    int16_t i = x >> 3;
+    int16_t b1, b2, r1, r2; //Bytes and rows of the sprite inside the clip region
+    int16_t b, r;
+
+    b1 = ((clip->xMin + 7) >> 3) - i;
+    b2 = ((clip->xMax + 1) >> 3) - 1 - i;
+    r1 = (clip->yMin > y) ? clip->yMin - y : 0;
+    r2 = (clip->yMax < y + height - 1) ? clip->yMax - y : height - 1;
+    if (b1 < 0) b1 = 0;
+    if (b2 > stride - 1) b2 = stride - 1;
+    if ((b1 > b2) || (r1 > r2)) {
+        return;
+    }
+
+    ink += r1 * stride;
+    mask += r1 * stride;
+    for (r = r1; r <= r2; r++) {
+        uint8_t *row = Sharp128x128_row(y + r) + i;
+
+        for (b = b1; b <= b2; b++) {
+            uint8_t value = (ink[b] & fore) | (~ink[b] & back);
+
+            row[b] = (row[b] & ~mask[b]) | (value & mask[b]);
+        }
+        ink += stride;
+        mask += stride;
+    }
+    Sharp128x128_markSpan(x + (b1 << 3), x + (b2 << 3) + 7, y + r1, y + r2);
+}
+
+#pragma SET_CODE_SECTION()
+
+#endif /* GFX_CORE */
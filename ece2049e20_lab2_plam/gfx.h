@@ -0,0 +1,177 @@
+/** gfx.h
+ *
+ *  Created on: Oct 19, 2026
+ *
+ * In-tree graphics core. Implements the part of the grlib API the labs use
+ * (context setup, clear, flush, filled rectangles, horizontal lines, text
+ * in uncompressed fonts up to 8 pixels wide and uncompressed 1 bit per pixel
+ * images) straight on top of the
+ * Sharp128x128 driver. Drawing writes the frame buffer through
+ * Sharp128x128_row() instead of calling through the g_sharp128x128LCD
+ * function table, and text is drawn a glyph row at a time instead of pixel
+ * run by pixel run, so none of the generic grlib paths end up in the image.
+ * Everything is source, so a build with program level optimization can
+ * inline the core into its callers.
+ *
+ * With GFX_CORE defined the Graphics_* calls below are macros for the gfx*
+ * functions, so existing code builds against the core unchanged. Contexts
+ * stay Graphics_Context and hold the same values grlib would store, so a
+ * call written as (Graphics_fillRectangle)(...) still reaches grlib.lib;
+ * the benchmark suite uses that to time both. Comment out GFX_CORE to go
+ * back to grlib for everything.
+ *
+ * Labels are constant strings whose length and centered position are
+ * worked out by the compiler. A lab lists its labels once with GFX_LABEL()
+ * and checks them with GFX_LABEL_CHECK(), which fails the build if a label
+ * does not fit the selected panel. gfxDrawLabel() then draws a label without
+ * measuring it, with either back end.
+ *
+ * gfxBlitScreen() replaces the whole frame with a 1-bpp image in the frame
+ * buffer's own layout, one row copy per line (see screens.h).
+ *
+ * gfxDrawAsset() draws a compressed image from assets.h, decoding it
+ * straight into the frame buffer.
+ *
+ * gfxDrawSprite() is the fast path for small images kept in RAM (see
+ * cards.c in lab 1): it only draws at byte aligned x, so every byte of the
+ * sprite is one read-modify-write of the frame buffer, with a mask for
+ * pixels that are left alone.
+ *
+ * Fills, lines and text drawn in ClrInvert (see Sharp128x128.h) toggle the
+ * pixels they cover, so a highlight is undone by drawing it again. Images,
+ * assets and sprites draw ClrInvert as white.
+ *
+ * gfxDrawStringScaled() draws text 2 to GFX_SCALE_MAX times larger for big
+ * numerals, widening glyph rows through a lookup table instead of drawing
+ * pixel by pixel. Without GFX_CORE, gfxDrawStringScaledCentered() and
+ * gfxDrawLabelScaled() fall back to text at its normal size.
+ */
+
+#ifndef GFX_H_
+#define GFX_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "grlib.h"
+
+#define GFX_CORE
+
+// Cell of g_sFontFixed6x8, the font the labels are laid out for
+#define GFX_FONT_WIDTH          6
+#define GFX_FONT_HEIGHT         8
+#define GFX_FONT_BASELINE       7
+
+typedef struct {
+    const char *text;
+    uint8_t length;
+    int16_t x; //Top left corner of the first character cell
+    int16_t y;
+} GfxLabel;
+
+// Position of string literal s centered on cx, cy, computed the same way
+// Graphics_drawStringCentered() does at run time
+#define GFX_LABEL_LENGTH(s)     ((int16_t)(sizeof(s) - 1))
+#define GFX_LABEL_X(s, cx)      ((cx) - (GFX_LABEL_LENGTH(s) * GFX_FONT_WIDTH) / 2)
+#define GFX_LABEL_Y(cy)         ((cy) - GFX_FONT_BASELINE / 2)
+
+#define GFX_LABEL(s, cx, cy)    { s, GFX_LABEL_LENGTH(s), GFX_LABEL_X(s, cx), GFX_LABEL_Y(cy) }
+
+#define GFX_LABEL_FITS(s, cx, cy) \
+    ((GFX_LABEL_X(s, cx) >= 0) && \
+     (GFX_LABEL_X(s, cx) + GFX_LABEL_LENGTH(s) * GFX_FONT_WIDTH <= LCD_HORIZONTAL_MAX) && \
+     (GFX_LABEL_Y(cy) >= 0) && \
+     (GFX_LABEL_Y(cy) + GFX_FONT_HEIGHT <= LCD_VERTICAL_MAX))
+
+// File scope check; a label that is cut off by the panel edge fails to
+// compile with a negative array size for name_fits_panel
+#define GFX_LABEL_CHECK(name, s, cx, cy) \
+    typedef char name##_fits_panel[GFX_LABEL_FITS(s, cx, cy) ? 1 : -1]
+
+#define gfxDrawLabel(c, label, o) \
+    Graphics_drawString((c), (uint8_t *)(label)->text, (label)->length, (label)->x, (label)->y, (o))
+
+#define GFX_SCALE_MAX           4
+
+// Top left corner of a label drawn scale times larger about the same center
+#define GFX_LABEL_SCALED_X(label, scale) \
+    ((label)->x - ((label)->length * GFX_FONT_WIDTH * ((scale) - 1)) / 2)
+#define GFX_LABEL_SCALED_Y(label, scale) \
+    ((label)->y + GFX_FONT_BASELINE / 2 - (GFX_FONT_BASELINE * (scale)) / 2)
+
+// 1-bpp image stored as a PackBits stream of its rows; set bits are ink,
+// drawn in the foreground color
+typedef struct {
+    uint16_t width;
+    uint16_t height;
+    uint16_t size; //Bytes of data
+    const uint8_t *data;
+} GfxAsset;
+
+#define GFX_ASSET_STRIDE(a)     (((a)->width + 7) >> 3)
+#define GFX_ASSET_RAW_SIZE(a)   (GFX_ASSET_STRIDE(a) * (a)->height)
+
+#ifdef GFX_CORE
+
+#if !defined(DISPLAY_SHARP128x128)
+#error "GFX_CORE only supports the Sharp128x128 driver"
+#endif
+#ifdef NON_VOLATILE_MEMORY_BUFFER
+#error "GFX_CORE needs the frame buffer in RAM"
+#endif
+
+void gfxInitContext(Graphics_Context *context, const Graphics_Display *display);
+void gfxClearDisplay(const Graphics_Context *context);
+void gfxFlushBuffer(const Graphics_Context *context);
+void gfxFillRectangle(const Graphics_Context *context, const Graphics_Rectangle *rect);
+void gfxDrawLineH(const Graphics_Context *context, int32_t x1, int32_t x2, int32_t y);
+int32_t gfxGetStringWidth(const Graphics_Context *context, const uint8_t *string, int32_t length);
+void gfxDrawString(const Graphics_Context *context, const uint8_t *string, int32_t length,
+                   int32_t x, int32_t y, bool opaque);
+void gfxDrawStringCentered(const Graphics_Context *context, const uint8_t *string, int32_t length,
+                           int32_t x, int32_t y, bool opaque);
+void gfxDrawStringScaled(const Graphics_Context *context, const uint8_t *string, int32_t length,
+                         int32_t x, int32_t y, uint8_t scale, bool opaque);
+void gfxDrawStringScaledCentered(const Graphics_Context *context, const uint8_t *string,
+                                 int32_t length, int32_t x, int32_t y, uint8_t scale, bool opaque);
+void gfxBlitScreen(const uint8_t *image);
+void gfxDrawImage(const Graphics_Context *context, const Graphics_Image *image,
+                  int16_t x, int16_t y);
+void gfxDrawAsset(const Graphics_Context *context, const GfxAsset *asset,
+                  int16_t x, int16_t y);
+void gfxDrawSprite(const Graphics_Context *context, const uint8_t *ink, const uint8_t *mask,
+                   int16_t stride, int16_t height, int16_t x, int16_t y);
+
+// grlib compatibility. Colors are stored translated to 0 (black), 1 (white)
+// or SHARP_COLOR_INVERT, as the Sharp128x128 color translation does.
+#define GFX_TRANSLATE_COLOR(v) \
+    (((v) == ClrInvert) ? SHARP_COLOR_INVERT : ((v) != ClrBlack))
+#define Graphics_initContext(c, d)              gfxInitContext((c), (d))
+#define Graphics_setForegroundColor(c, v)       ((c)->foreground = GFX_TRANSLATE_COLOR(v))
+#define Graphics_setBackgroundColor(c, v)       ((c)->background = GFX_TRANSLATE_COLOR(v))
+#define Graphics_setFont(c, f)                  ((c)->font = (f))
+#define Graphics_clearDisplay(c)                gfxClearDisplay(c)
+#define Graphics_flushBuffer(c)                 gfxFlushBuffer(c)
+#define Graphics_fillRectangle(c, r)            gfxFillRectangle((c), (r))
+#define Graphics_drawLineH(c, x1, x2, y)        gfxDrawLineH((c), (x1), (x2), (y))
+#define Graphics_getStringWidth(c, s, n) \
+    gfxGetStringWidth((c), (const uint8_t *)(s), (n))
+#define Graphics_drawString(c, s, n, x, y, o) \
+    gfxDrawString((c), (const uint8_t *)(s), (n), (x), (y), (o))
+#define Graphics_drawStringCentered(c, s, n, x, y, o) \
+    gfxDrawStringCentered((c), (const uint8_t *)(s), (n), (x), (y), (o))
+#define Graphics_drawImage(c, i, x, y)          gfxDrawImage((c), (i), (x), (y))
+
+#define gfxDrawLabelScaled(c, label, scale, o) \
+    gfxDrawStringScaled((c), (const uint8_t *)(label)->text, (label)->length, \
+                        GFX_LABEL_SCALED_X((label), (scale)), GFX_LABEL_SCALED_Y((label), (scale)), \
+                        (scale), (o))
+
+#else
+
+#define gfxDrawStringScaledCentered(c, s, n, x, y, scale, o) \
+    Graphics_drawStringCentered((c), (s), (n), (x), (y), (o))
+#define gfxDrawLabelScaled(c, label, scale, o)  gfxDrawLabel((c), (label), (o))
+
+#endif /* GFX_CORE */
+
+#endif /* GFX_H_ */
@@ -0,0 +1,186 @@
+/** highway.c
+ *
+ *  Created on: Oct 19, 2026
+ *
+ * Falling note highway. See highway.h.
+ *
+ * Song time s (in pixels, ticks / HIGHWAY_TICKS_PER_PX) is drawn on row
+ * offset + HIGHWAY_HIT_Y - s, so the hit line shows the current position
+ * and the top row the furthest look-ahead.
+ */
+
+#include <msp430.h>
+#include "peripherals.h"
+#include "display.h"
+#include "highway.h"
+#include "timebase.h"
+#include "utils/profile.h"
+
+#define LANE_WIDTH  (LCD_HORIZONTAL_MAX / HIGHWAY_LANES)
+#define TO_PX(t)    ((unsigned int)((t) / HIGHWAY_TICKS_PER_PX))
+
+/*
+ * Fills the lanes set in led between rows yTop and yBottom in the
+ * foreground color
+ */
+static void drawBlock(char led, int yTop, int yBottom)
+{
+    Graphics_Rectangle rect;
+    int lane;
+
+    rect.yMin = yTop;
+    rect.yMax = yBottom;
+    for (lane = 0; lane < HIGHWAY_LANES; lane++) {
+        if (led & (1 << lane)) {
+            rect.xMin = lane * LANE_WIDTH + 2;
+            rect.xMax = (lane + 1) * LANE_WIDTH - 3;
+            Graphics_fillRectangle(&g_sContext, &rect);
+        }
+    }
+}
+
+/*
+ * Inverts the lanes set in led between rows yTop and yBottom, after clipping
+ * them to the rows above the hit line. Does nothing if none are left.
+ */
+static void invertBlock(char led, int yTop, int yBottom)
+{
+    if (yTop < 0) {
+        yTop = 0;
+    }
+    if (yBottom > HIGHWAY_HIT_Y - 1) {
+        yBottom = HIGHWAY_HIT_Y - 1;
+    }
+    if (yTop <= yBottom) {
+        drawBlock(led, yTop, yBottom);
+    }
+}
+
+/*
+ * Moves every note above the hit line from song position from to to, which
+ * is to - from rows down. Only the rows a note left at its top and entered
+ * at its bottom are inverted; the rows it still covers are not touched. The notes of a lane never overlap, so
+ * inverting each one's rows in turn leaves every row right even where a
+ * note moves into the rows another one left. With the area above the line
+ * blank and redraw set, the notes are drawn at to from scratch.
+ */
+static void moveNotes(Highway *highway, unsigned int from, unsigned int to, int redraw)
+{
+    const PlaySession *session = highway->session;
+    unsigned long noteStart = highway->bottomStart;
+    int i = highway->bottomNote;
+
+    //Song pixel s is on row from + HIGHWAY_HIT_Y - s before the move and
+    //to + HIGHWAY_HIT_Y - s after it; notes that ended on or below the hit
+    //line are gone for good
+    while (i < session->size) {
+        const Note *note = &session->song[i];
+        unsigned int start = TO_PX(noteStart);
+        unsigned int end = TO_PX(noteStart + note->duration);
+        unsigned int runEnd = (end > start + HIGHWAY_GAP_PX) ? end - HIGHWAY_GAP_PX : start;
+        int oldTop = (int)(from - runEnd) + HIGHWAY_HIT_Y + 1;
+        int oldBottom = (int)(from - start) + HIGHWAY_HIT_Y;
+        int rows = (int)(to - from);
+
+        if (start > to + HIGHWAY_HIT_Y) { //Still above the top edge, and so are the rest
+            break;
+        }
+        noteStart += note->duration;
+        i++;
+        if (runEnd <= to) { //Below the hit line from now on
+            highway->bottomNote = i;
+            highway->bottomStart = noteStart;
+        }
+        if (runEnd == start) {
+            continue;
+        }
+
+        Graphics_setForegroundColor(&g_sContext, ClrInvert);
+        if (redraw) {
+            invertBlock(note->led, oldTop + rows, oldBottom + rows);
+        } else if (rows > oldBottom - oldTop) { //Moved clear of its old rows
+            invertBlock(note->led, oldTop, oldBottom);
+            invertBlock(note->led, oldTop + rows, oldBottom + rows);
+        } else {
+            invertBlock(note->led, oldTop, oldTop + rows - 1); //Trailing rows
+            invertBlock(note->led, oldBottom + 1, oldBottom + rows); //Leading rows
+        }
+        Graphics_setForegroundColor(&g_sContext, ClrBlack);
+    }
+}
+
+/*
+ * Fills the lanes of the buttons that are held below the hit line. Only
+ * lanes whose button changed since the last frame are touched.
+ */
+static void drawHeld(Highway *highway, char buttons)
+{
+    char changed = (buttons ^ highway->held) & ((1 << HIGHWAY_LANES) - 1);
+
+    if (changed != 0) {
+        Graphics_setForegroundColor(&g_sContext, ClrInvert);
+        drawBlock(changed, HIGHWAY_HIT_Y + 3, LCD_VERTICAL_MAX - 1);
+        Graphics_setForegroundColor(&g_sContext, ClrBlack);
+        highway->held ^= changed;
+    }
+}
+
+/*
+ * Draws the first screen of the session's song. The session must have been
+ * started with the same now.
+ */
+void highwayStart(Highway *highway, const PlaySession *session, unsigned long now)
+{
+    highway->session = session;
+    highway->note = 0;
+    highway->noteTicks = 0;
+    highway->bottomNote = 0;
+    highway->bottomStart = 0;
+    highway->offset = 0;
+    highway->held = 0;
+    highway->lastFrame = (uint16_t)now;
+
+    Graphics_clearDisplay(&g_sContext);
+    moveNotes(highway, 0, 0, 1);
+    Graphics_drawLineH(&g_sContext, 0, LCD_HORIZONTAL_MAX - 1, HIGHWAY_HIT_Y);
+    displayInvalidate();
+}
+
+/*
+ * Draws a frame if HIGHWAY_FRAME_TICKS have passed since the last one.
+ * The song position is taken from the session, so the picture follows the
+ * notes the session is actually scoring. Returns 1 if a frame was drawn.
+ */
+int highwayRender(Highway *highway, unsigned long now, char buttons)
+{
+    const PlaySession *session = highway->session;
+    unsigned int px;
+
+    if (TIMEBASE_ELAPSED16(now, highway->lastFrame) < HIGHWAY_FRAME_TICKS) {
+        return 0;
+    }
+    if (session->note >= session->size) {
+        return 0;
+    }
+    highway->lastFrame = (uint16_t)now;
+
+    PROFILE_BEGIN(PROF_HIGHWAY);
+
+    while (highway->note < session->note) { //Catch up with notes the session finished
+        highway->noteTicks += session->song[highway->note].duration;
+        highway->note++;
+    }
+    px = TO_PX(highway->noteTicks + (now - session->noteStart));
+
+    //The session starts a note on the poll after the previous one ended, so
+    //the position can step back by a tick; hold the picture until it catches up
+    if (px > highway->offset) {
+        moveNotes(highway, highway->offset, px, 0);
+        highway->offset = px;
+    }
+    drawHeld(highway, buttons); //The hit line itself is never redrawn
+    displayInvalidate();
+
+    PROFILE_END(PROF_HIGHWAY);
+    return 1;
+}
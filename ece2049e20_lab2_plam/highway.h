@@ -0,0 +1,45 @@
+/** highway.h
+ *
+ *  Created on: Oct 19, 2026
+ *
+ * Note highway for the PLAY screen. Upcoming notes of the song fall down
+ * four lanes (blue, red, yellow, green from the left) towards a hit line;
+ * a note reaches the line when it has to be played. Below the line the
+ * lanes of the buttons being held are filled in.
+ *
+ * highwayRender() is polled from the main loop after sessionTick() and only
+ * draws every HIGHWAY_FRAME_TICKS timebase ticks. The background stays
+ * still: a frame inverts just the rows each note left at its top and
+ * entered at its bottom, and the held lanes whose button changed. The hit
+ * line is never redrawn. Only those rows are marked for the next flush, so
+ * the bus time of a frame depends on how many note edges are on screen and
+ * the fall speed, not on the screen height.
+ */
+
+#ifndef HIGHWAY_H_
+#define HIGHWAY_H_
+
+#include <stdint.h>
+#include "session.h"
+
+#define HIGHWAY_LANES           4
+#define HIGHWAY_HIT_Y           112 //Row of the hit line
+#define HIGHWAY_TICKS_PER_PX    2   //Fall speed; the look-ahead is HIGHWAY_HIT_Y * 2 ticks (~1.1 s)
+#define HIGHWAY_FRAME_TICKS     8   //One frame every 40 ms
+#define HIGHWAY_GAP_PX          3   //Blank rows at the end of every note, so repeats stay apart
+
+typedef struct {
+    const PlaySession *session;
+    int note; //Session note that noteTicks belongs to
+    unsigned long noteTicks; //Song time that note starts at
+    int bottomNote; //First note not yet below the hit line
+    unsigned long bottomStart; //Song time bottomNote starts at
+    unsigned int offset; //Song time at the hit line, in pixels
+    char held; //Lanes filled in below the hit line
+    uint16_t lastFrame; //Low 16 bits of the tick of the last frame
+} Highway;
+
+void highwayStart(Highway *highway, const PlaySession *session, unsigned long now);
+int highwayRender(Highway *highway, unsigned long now, char buttons);
+
+#endif
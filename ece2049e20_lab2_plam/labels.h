@@ -0,0 +1,50 @@
+/** labels.h
+ *
+ *  Created on: Oct 19, 2026
+ *
+ * Constant text of the MSP430 Hero screens. Each label is listed once in
+ * LABELS with its string and the point it is centered on; labels.c turns
+ * the list into a table laid out at compile time and checks that every
+ * label fits the panel. Draw a label with drawLabel(id), or scale times
+ * larger about the same center with drawLabelScaled(id, scale). Scores are
+ * drawn with gfxDrawStringScaledCentered().
+ */
+
+#ifndef LABELS_H_
+#define LABELS_H_
+
+#include "peripherals.h"
+
+//    id                    text                    x   y
+#define LABELS(X) \
+    X(LABEL_TITLE,          "MSP430 Hero",          64, 55) \
+    X(LABEL_PUSH_TO_START,  "Push Right to Start",  64, 65) \
+    X(LABEL_COUNT_3,        "3",                    64, 64) \
+    X(LABEL_COUNT_2,        "2",                    64, 64) \
+    X(LABEL_COUNT_1,        "1",                    64, 64) \
+    X(LABEL_COUNT_START,    "START",                64, 64) \
+    X(LABEL_SONG_COMPLETE,  "Song Complete!",       64, 45) \
+    X(LABEL_SCORE,          "Score (/24):",         64, 65) \
+    X(LABEL_TRY_AGAIN,      "Try again",            64, 35) \
+    X(LABEL_MISSED_NOTES,   "Missed notes:",        64, 50) \
+    X(LABEL_WRONG_NOTES,    "Wrong notes:",         64, 82)
+
+// Sizes of the countdown and of the numbers on the end screens
+#define COUNTDOWN_SCALE     4
+#define SCORE_SCALE         3
+#define NOTES_SCALE         2   //Missed and wrong notes
+
+#define LABEL_ID(id, text, x, y)    id,
+
+typedef enum {
+    LABELS(LABEL_ID)
+    NUM_LABELS
+} labelId;
+
+extern const GfxLabel g_labels[NUM_LABELS];
+
+#define drawLabel(id)   gfxDrawLabel(&g_sContext, &g_labels[(id)], TRANSPARENT_TEXT)
+#define drawLabelScaled(id, scale) \
+    gfxDrawLabelScaled(&g_sContext, &g_labels[(id)], (scale), TRANSPARENT_TEXT)
+
+#endif
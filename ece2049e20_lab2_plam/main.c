@@ -10,59 +10,69 @@
 
 #include <msp430.h>
 #include "peripherals.h"
+#include "clock.h"
 #include "note.h"
 #include "songs.h"
-#include "utils/ustdlib.h"
+#include "session.h"
+#include "highway.h"
+#include "timebase.h"
+#include "debounce.h"
+#include "display.h"
+#include "labels.h"
+#include "screens.h"
+#include "utils/fmt.h"
 #include "utils/debug_assert.h"
+#include "utils/profile.h"
+#include "utils/bench.h"
 
 typedef enum {START, TEST, COUNTDOWN, PLAY, WIN, LOSE} gameStates;
 
 //Function Prototypes
 void swDelay(char numLoops);
-void startTimerA2(void);
 void playTune(Note tune[],int size);
 void Welcome(void);
-int playSong(Note song[], int size);
 int countdown(int elapsed_time);
-void playerWin(void);
-void playerLose(void);
+void playerWin(const SessionResult *result);
+void playerLose(const SessionResult *result);
 void resetGlobals(void);
-
-//Global time count, storing number of timer ticks at 0.005 s/tick
-volatile unsigned long timer = 0;
-
-#pragma vector = TIMER2_A0_VECTOR
-__interrupt void TimerA2_ISR(void) {
-    timer++;
-}
+#ifdef BENCH_ENABLE
+void runBenchmarks(void);
+#endif
 
 //Global variables
-unsigned long previous_time = 0; //Time mark for reference
+unsigned long previous_time = 0; //Time mark for reference, in timebase ticks (0.005 s/tick)
 int current_note = 0; //Index in songs
 char loop; //Counter to determine if the intro song needs to be played
 int count = 0; //Counter for the count down screen
-int miss = 0; //Missed notes
-int error = 0; //Wrong notes
-int a_score = ARRAY2_SIZE(astronomia); //Total possible score. Will decrement provided errors.
+PlaySession session; //Current play-through, holds the score for the WIN and LOSE screens
+Highway highway; //Falling notes drawn during PLAY
 
 
 void main(void)
 {
     gameStates state = START;
     char ebutton_state; //Stores state of external buttons
-    char lbutton_state; //Stores state of Launchpad board buttons
+    DebounceEvents events; //Button edges since the last poll
+    unsigned long now; //Tick the current PLAY poll runs at
 
     WDTCTL = WDTPW | WDTHOLD; //Stop watchdog timer
     _BIS_SR(GIE);  //Enable global interrupt
 
     //System initialization
+    initClock(); //Must run before any peripheral that uses SMCLK
+    profileInit(); //No-op unless PROFILE_ENABLE is defined in profile.h
     initButtons();
     initLeds();
     initLaunchpadButtons();
     initLaunchpadLeds();
     configDisplay();
 
-    startTimerA2(); //Start Timer
+    debounceInit();
+    timebaseInit(); //Start Timer, its tick samples the buttons
+
+#ifdef BENCH_ENABLE
+    runBenchmarks(); //Reports over the UART and halts; the game does not run
+#endif
 
     while (1)
     {
@@ -70,57 +80,62 @@ void main(void)
         case START:
             resetGlobals();
             Welcome();
+            debounceTake(&events); //Drop presses made during the intro
             state = TEST;
             break;
         case TEST:
-            lbutton_state = readLaunchpadButtons(); //Read Launchpad buttons
-            ebutton_state = readButtons(); //Read external buttons
+            ebutton_state = debounceState() & INPUT_EXTERNAL; //Read external buttons
             configLeds(ebutton_state);
-            if (lbutton_state & BUTTON_RIGHT) { //If right Launchpad button is pressed, start game
+            debounceTake(&events);
+            if (events.pressed & INPUT_RIGHT) { //If right Launchpad button is pressed, start game
                 Graphics_clearDisplay(&g_sContext);
-                previous_time = timer;
+                previous_time = timebaseNow();
                 state = COUNTDOWN;
             }
             break;
         case COUNTDOWN:
             BuzzerOff();
-            if (countdown(timer - previous_time) == 1) { //Displays a count down
+            if (countdown(TIMEBASE_ELAPSED16(timebaseNow16(), previous_time)) == 1) { //Displays a count down
                 Graphics_clearDisplay(&g_sContext);
                 swDelay(1);
-                previous_time = timer;
+                previous_time = timebaseNow();
+                sessionStart(&session, astronomia, ARRAY2_SIZE(astronomia), previous_time);
+                highwayStart(&highway, &session, previous_time);
                 state = PLAY;
             }
             break;
         case PLAY:
-            if (playSong(astronomia, ARRAY2_SIZE(astronomia)) == 1) {
+            ebutton_state = debounceState() & INPUT_EXTERNAL;
+            now = timebaseNow();
+            switch (sessionTick(&session, now, ebutton_state)) { //Advances the song by one poll
+            case SESSION_WON:
                 swDelay(3);
+                Graphics_clearDisplay(&g_sContext);
                 state = WIN;
-            } else if (playSong(astronomia, ARRAY2_SIZE(astronomia)) == 2) {
+                break;
+            case SESSION_LOST:
                 swDelay(3);
+                Graphics_clearDisplay(&g_sContext);
                 state = LOSE;
+                break;
+            default:
+                highwayRender(&highway, now, ebutton_state); //Draws only once per frame period, after input is sampled
+                break;
             }
         break;
         case WIN:
-            playerWin();
+            playerWin(&session.result);
             state = START;
         break;
         case LOSE:
-            playerLose();
+            playerLose(&session.result);
             state = START;
         break;
         }
+        displayService(); //Sends at most one frame per display period
     }
 }
 
-/*
- * Starts the timer
- */
-void startTimerA2(void) {
-    TA2CTL = TASSEL_1 | ID_0 | MC_1; //Using ACLK, divide by 1, UP mode
-    TA2CCR0 = 163; //Max count = 32768 Hz * 0.005 s - 1
-    TA2CCTL0 = CCIE; //Enable capture/compare interrupt
-}
-
 /*
  * Displays welcome screen and plays intro song to test the buzzer
  */
@@ -129,10 +144,9 @@ void Welcome(void) {
         playTune(start_up,ARRAY_SIZE(start_up));
         loop++;
     }
-    Graphics_drawStringCentered(&g_sContext, "MSP430 Hero",       AUTO_STRING_LENGTH, 64, 55, TRANSPARENT_TEXT);
-    Graphics_drawStringCentered(&g_sContext, "Push Right to Start", AUTO_STRING_LENGTH, 64, 65, TRANSPARENT_TEXT);
+    drawScreen(SCREEN_TITLE); //Replaces whatever the last song left on screen
 
-    Graphics_flushBuffer(&g_sContext);
+    displayInvalidate();
 }
 
 /*
@@ -141,11 +155,10 @@ void Welcome(void) {
 void playTune(Note tune[],int size) {
     for (current_note = 0; current_note < size; current_note++) { //Index through the song
 
-        while (timer - previous_time < tune[current_note].duration) { //Switches on the buzzer and LEDs during note duration
-            BuzzerOn(tune[current_note].pitch);
-            configLeds(tune[current_note].led);
-        }
-        previous_time = timer; //Get time mark
+        BuzzerOn(tune[current_note].pitch); //Switches on the buzzer and LEDs during note duration
+        configLeds(tune[current_note].led);
+        timebaseWaitUntil(previous_time + tune[current_note].duration); //Sleeps instead of polling
+        previous_time = timebaseNow(); //Get time mark
     }
     configLeds(0); //Switch off LEDs and buzzer once song is complete
     BuzzerOff();
@@ -157,93 +170,50 @@ void playTune(Note tune[],int size) {
  */
 int countdown(int elapsed_time) {
     if (count == 0 && elapsed_time > 0) {
-        Graphics_drawStringCentered(&g_sContext, "3", 1, 64, 64, TRANSPARENT_TEXT);
+        drawLabelScaled(LABEL_COUNT_3, COUNTDOWN_SCALE);
         configLeds(GREEN);
-        Graphics_flushBuffer(&g_sContext);
+        displayInvalidate();
         count++;
     } else if (count == 1 && elapsed_time > 200) {
         Graphics_clearDisplay(&g_sContext);
-        Graphics_drawStringCentered(&g_sContext, "2", 1, 64, 64, TRANSPARENT_TEXT);
+        drawLabelScaled(LABEL_COUNT_2, COUNTDOWN_SCALE);
         configLeds(YELLOW);
-        Graphics_flushBuffer(&g_sContext);
+        displayInvalidate();
         count++;
     } else if (count == 2 && elapsed_time > 400) {
         Graphics_clearDisplay(&g_sContext);
-        Graphics_drawStringCentered(&g_sContext, "1", 1, 64, 64, TRANSPARENT_TEXT);
+        drawLabelScaled(LABEL_COUNT_1, COUNTDOWN_SCALE);
         configLeds(RED);
-        Graphics_flushBuffer(&g_sContext);
+        displayInvalidate();
         count++;
     } else if (count == 3 && elapsed_time > 600) {
         Graphics_clearDisplay(&g_sContext);
-        Graphics_drawStringCentered(&g_sContext, "START", 5, 64, 64, TRANSPARENT_TEXT);
+        drawLabelScaled(LABEL_COUNT_START, COUNTDOWN_SCALE);
         configLeds(BLUE);
-        Graphics_flushBuffer(&g_sContext);
+        displayInvalidate();
         swDelay(2);
         return 1;
     }
     return 0;
 }
 
-/*
- * Plays a song on the buzzer. Prompts user to press the correct button according to
- * theLED. LEDs light up first. If the correct button is pressed, the correct
- * note is played. Otherwise, an off-sounding note is played. Points are deducted if
- * the wrong button or if no buttons are pressed during a note.
- */
-int playSong(Note song[], int size) {
-    char button_state;
-    int pass = 0;
-
-    for (current_note = 0; current_note < size; current_note++) { //Index through the song
-        pass = 0;
-
-        while (timer - previous_time < song[current_note].duration) { //Read the state of the buttons while note is played
-            configLeds(song[current_note].led); //Set LEDs to notes
-            button_state = readButtons();
-                if (button_state == song[current_note].led) { //If the correct button is pressed
-                    setLaunchpadLeds(0x01); //Enable the green Launchpad LED
-                    setLaunchpadLeds(0x00);
-                    BuzzerOn(song[current_note].pitch); //Play correct note
-                    pass = 1;
-                } else if (button_state != song[current_note].led && button_state != 0) { //If the wrong button is pressed
-                    BuzzerOn(NOTE_G6); //Play bad note
-                    pass = 2;
-                }
-            }
-
-            if (pass == 2) { //Make note of error if wrong button is pressed
-                error++;
-            } else if (pass == 0 && button_state == 0 && miss < 10) { //Make sure miss is not off by one
-                miss++; //Keep track of missed notes
-            }
-
-            if ((error + miss) >= 10) { //If total errors are greater than 10
-                BuzzerOff();
-                configLeds(0);
-                return 2; //Break out of loop
-            }
-
-        previous_time = timer; //Get time mark
-    }
-    configLeds(0);
-    BuzzerOff();
-    return 1;
-}
-
 /*
  * Displays win screen, including total score calculated based on number of correct notes pressed
  */
-void playerWin(void) {
+void playerWin(const SessionResult *result) {
 
-    unsigned char str[3]; //Create buffer to store and display score data
-    a_score -= (error + miss);
-    Graphics_drawStringCentered(&g_sContext, "Song Complete!", AUTO_STRING_LENGTH, 64, 45, TRANSPARENT_TEXT);
-    Graphics_drawStringCentered(&g_sContext, "Score (/24):", AUTO_STRING_LENGTH, 64, 65, TRANSPARENT_TEXT);
-    usnprintf(str,3,"%d",a_score);
-    Graphics_drawStringCentered(&g_sContext, str, 3, 64, 75, TRANSPARENT_TEXT);
-    Graphics_flushBuffer(&g_sContext);
+    unsigned char str[FMT_I16_SIZE]; //Create buffer to store and display score data
+    int len;
+    drawLabel(LABEL_SONG_COMPLETE);
+    drawLabel(LABEL_SCORE);
+    len = fmt_i16(str, result->score);
+    gfxDrawStringScaledCentered(&g_sContext, str, len, 64, 88, SCORE_SCALE, TRANSPARENT_TEXT);
+    displayPresent(); //Shown before the tune blocks the main loop
 
-    previous_time = timer;
+    profileDumpUart(); //Report timing for the finished song (PROFILE_ENABLE only)
+    displayDumpUart();
+
+    previous_time = timebaseNow();
     playTune(win, ARRAY3_SIZE(win)); //Play celebratory song
 
     swDelay(10); //Write delay to allow time to read screen
@@ -252,21 +222,23 @@ void playerWin(void) {
 /*
  * Displays lose screen, including total errors and missed notes
  */
-void playerLose(void) {
-
-    unsigned char str[3];
-    unsigned char str2[3];
-    a_score -= (error + miss);
-    Graphics_drawStringCentered(&g_sContext, "Try again", AUTO_STRING_LENGTH, 64, 35, TRANSPARENT_TEXT);
-    Graphics_drawStringCentered(&g_sContext, "Missed notes:", AUTO_STRING_LENGTH, 64, 55, TRANSPARENT_TEXT);
-    usnprintf(str, 3, "%d", miss);
-    Graphics_drawStringCentered(&g_sContext, str, 2, 64, 65, TRANSPARENT_TEXT);
-    Graphics_drawStringCentered(&g_sContext, "Wrong notes:", AUTO_STRING_LENGTH, 64, 75, TRANSPARENT_TEXT);
-    usnprintf(str2, 3, "%d", error);
-    Graphics_drawStringCentered(&g_sContext, str2, 2, 64, 85, TRANSPARENT_TEXT);
-    Graphics_flushBuffer(&g_sContext);
-
-    previous_time = timer;
+void playerLose(const SessionResult *result) {
+
+    unsigned char str[FMT_I16_SIZE];
+    int len;
+    drawLabel(LABEL_TRY_AGAIN);
+    drawLabel(LABEL_MISSED_NOTES);
+    len = fmt_i16(str, result->misses);
+    gfxDrawStringScaledCentered(&g_sContext, str, len, 64, 64, NOTES_SCALE, TRANSPARENT_TEXT);
+    drawLabel(LABEL_WRONG_NOTES);
+    len = fmt_i16(str, result->errors);
+    gfxDrawStringScaledCentered(&g_sContext, str, len, 64, 96, NOTES_SCALE, TRANSPARENT_TEXT);
+    displayPresent(); //Shown before the tune blocks the main loop
+
+    profileDumpUart(); //Report timing for the finished song (PROFILE_ENABLE only)
+    displayDumpUart();
+
+    previous_time = timebaseNow();
     playTune(shut_down, ARRAY4_SIZE(shut_down)); //Play sad song
 
     swDelay(10); //Write delay to allow time to read screen
@@ -278,14 +250,55 @@ void playerLose(void) {
 void resetGlobals() {
     previous_time = 0;
     count = 0;
-    miss = 0;
-    error = 0;
-    a_score = ARRAY2_SIZE(astronomia);
     Graphics_clearDisplay(&g_sContext);
 }
 
+#ifdef BENCH_ENABLE
+/*
+ * Benchmark suite. Runs the shared graphics workloads and the per-frame
+ * text and LED work, writes one JSON line per workload to the UART, then halts.
+ */
+void runBenchmarks(void)
+{
+    int n = 0;
+    unsigned long now = 0;
+
+    benchBegin();
+    benchGraphics();
+
+    BENCH("config_leds", 256, configLeds(n++ & 0x0F));
+    configLeds(0);
+
+    //The title prompt measured at run time and from the label table
+    BENCH("draw_string_centered_prompt", 64,
+          Graphics_drawStringCentered(&g_sContext, "Push Right to Start", AUTO_STRING_LENGTH, 64, 65, TRANSPARENT_TEXT));
+    BENCH("draw_label_prompt", 64, drawLabel(LABEL_PUSH_TO_START));
+
+    //A countdown numeral at its normal size and as drawn
+    BENCH("draw_label_count", 64, drawLabel(LABEL_COUNT_3));
+    BENCH("draw_label_count_scaled", 64, drawLabelScaled(LABEL_COUNT_3, COUNTDOWN_SCALE));
+
+    //Title screen copied from its flash image, then drawn from its labels
+    BENCH("draw_screen_title", 16, drawScreen(SCREEN_TITLE));
+    BENCH("screen_labels_title", 16, screenDrawLabels(SCREEN_TITLE));
+
+    //One frame of falling notes per iteration, the song advancing a frame
+    //period each time; the flush is not included
+    sessionStart(&session, astronomia, ARRAY2_SIZE(astronomia), now);
+    highwayStart(&highway, &session, now);
+    BENCH("highway_frame", 64, highwayRender(&highway, now += HIGHWAY_FRAME_TICKS, 0x0F));
+
+    //One sample of all six buttons, the work the timebase ISR adds per tick
+    BENCH("debounce_tick", 256, debounceTick());
+
+    benchEnd();
+    while (1);
+}
+#endif
+
 /*
- * Software delay. Performs useless loops to waste a bit of time
+ * Software delay. Performs useless loops to waste a bit of time. The display
+ * is serviced between loops so a frame drawn just before the delay is shown.
  * Input: numLoops = number of delay loops to execute
  * Output: none
  */
@@ -294,8 +307,9 @@ void swDelay(char numLoops)
 	volatile unsigned int i,j;	// volatile to prevent removal in optimization
 			                    // by compiler. Functionally this is useless code
 
-	for (j=0; j<numLoops; j++)
+	for (j=0; j<numLoops * SWDELAY_SCALE; j++) // scaled so the delay is independent of MCLK
     {
+    	displayService();
     	i = 50000 ;					// SW Delay
    	    while (i > 0)				// could also have used while (i)
 	       i--;
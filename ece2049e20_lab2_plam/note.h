@@ -9,12 +9,13 @@
 #define NOTE_H
 
 /* Structure to define a note in a song. Each note has a set pitch, length, and LED
- * that lights up when it is played.
+ * that lights up when it is played. led is a lane mask of BLUE, RED, YELLOW and
+ * GREEN; a note with more than one lane set is a chord, e.g. BLUE | YELLOW.
  */
 typedef struct {
     unsigned int pitch;
     unsigned int duration;
-    char led;
+    char led; //Lanes to press, all at once for a chord
 } Note;
 
 #define NOTE_E4 330
@@ -14,6 +14,8 @@
  */
 
 #include "peripherals.h"
+#include "display.h"
+#include "debounce.h"
 
 
 // Globals
@@ -87,39 +89,29 @@ void initButtons(void) {
 
 
 /*
- * Reads the state of the external buttons and returns it
+ * Reads the state of the external buttons and returns it as a lane mask:
+ * blue BIT0, red BIT1, yellow BIT2, green BIT3. The port pins are already
+ * in that order, so one read of P6IN gives every button at the same instant.
  */
 char readButtons(void) {
-    char val;
-    char bb = (~P6IN & BIT0); //Blue button
-    char br = (~P6IN & BIT1) >> 1; //Red button
-    char by = (~P6IN & BIT2) >> 2; //Yellow button
-    char bg = (~P6IN & BIT3) >> 3; //Green button
+    return ~P6IN & (BIT3|BIT2|BIT1|BIT0);
+}
 
-    val = (bg <<3) | (by << 2) | (br << 1) | bb;
 
-    return val;
-}
+#define LED_PINS    (BIT5|BIT4|BIT3|BIT2)
 
+//Lane mask to P1OUT bits: blue P1.5, red P1.4, yellow P1.3, green P1.2
+static const unsigned char ledPins[16] = {
+    0x00, 0x20, 0x10, 0x30, 0x08, 0x28, 0x18, 0x38,
+    0x04, 0x24, 0x14, 0x34, 0x0C, 0x2C, 0x1C, 0x3C
+};
 
 /*
- * Lights up external LED based on button pressed.
+ * Lights the external LEDs of every lane set in button_state, so a chord
+ * lights all of its LEDs. One table lookup and a single write to P1OUT.
  */
 void configLeds(char button_state) {
-    unsigned char x = 0x00;
-
-    P1OUT &= ~(BIT5 | BIT4 | BIT3 | BIT2); //Turn of all LEDs initially
-
-    if (button_state & BIT0) {
-        x |= BIT5;
-    } else if (button_state & BIT1) {
-        x |= BIT4;
-    } else if (button_state & BIT2) {
-        x |= BIT3;
-    } else if (button_state & BIT3) {
-        x |= BIT2;
-    }
-    P1OUT |= x;
+    P1OUT = (P1OUT & ~LED_PINS) | ledPins[button_state & 0x0F];
 }
 
 /*
@@ -162,6 +154,15 @@ char readLaunchpadButtons(void)
 }
 
 
+/*
+ * Raw buttons for the debouncer, laid out as the INPUT_ bits
+ */
+uint8_t debounceRead(void)
+{
+    return readButtons() | (readLaunchpadButtons() << 4);
+}
+
+
 /*
  * Initializes the LEDs on the Launchpad board
  */
@@ -225,20 +226,8 @@ void configDisplay(void)
     Graphics_setFont(&g_sContext, &g_sFontFixed6x8);
     Graphics_clearDisplay(&g_sContext);
     Graphics_flushBuffer(&g_sContext);
-}
 
-
-//------------------------------------------------------------------------------
-// Timer1 A0 Interrupt Service Routine
-//------------------------------------------------------------------------------
-#pragma vector=TIMER1_A0_VECTOR
-__interrupt void TIMER1_A0_ISR (void)
-{
-	// Display is using Timer A1
-	// Not sure where Timer A1 is configured?
-#if defined(DISPLAY_SHARP96x96)
-	Sharp96x96_SendToggleVCOMCommand();  // display needs this toggle < 1 per sec
-#elif defined(DISPLAY_SHARP128x128)
-	Sharp128x128_SendToggleVCOMCommand();
-#endif
+    // Timer A1 paces frames and the VCOM toggle, see display.c. Needs GIE.
+    displayInit();
 }
+
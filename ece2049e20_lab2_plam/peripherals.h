@@ -30,6 +30,10 @@
 #include "LcdDriver/sharp128/HAL_MSP_EXP430F5529_Sharp128x128.h"
 #endif
 
+// In-tree graphics core; turns the Graphics_* calls below into direct calls
+// to the display driver (see gfx.h)
+#include "gfx.h"
+
 
 
 
@@ -80,6 +84,10 @@ extern tContext g_sContext;	// user defined type used by graphics library
 // Define Launchpad buttons
 #define BUTTON_RIGHT 0x01
 
+// Debounced inputs: external buttons in the low nibble, Launchpad buttons above
+#define INPUT_EXTERNAL  0x0F
+#define INPUT_RIGHT     (BUTTON_RIGHT << 4)
+
 // Prototypes for functions defined implemented in peripherals.c
 void configDisplay(void);
 void BuzzerOn(int freq);
@@ -0,0 +1,137 @@
+/** session.c
+ *
+ *  Created on: Oct 19, 2026
+ *
+ * Play session state and scoring. See session.h.
+ */
+
+#include <msp430.h>
+#include "peripherals.h"
+#include "note.h"
+#include "session.h"
+#include "utils/profile.h"
+
+/*
+ * Scores the note that just ended. Returns 1 if the session is lost.
+ */
+static int sessionScoreNote(PlaySession *session)
+{
+    SessionResult *result = &session->result;
+
+    if (session->pass == 1) {
+        result->hits++;
+    } else if (session->pass == 2) { //Make note of error if wrong button is pressed
+        result->errors++;
+    } else if (session->pass == 3) { //Only part of a chord was pressed
+        result->partials++;
+    } else if (result->misses < SESSION_MAX_MISTAKES) { //Make sure miss is not off by one
+        result->misses++; //Keep track of missed notes
+    }
+
+    return (result->errors + result->misses) >= SESSION_MAX_MISTAKES;
+}
+
+/*
+ * Stops the session with the given outcome and fills in the totals
+ */
+static sessionOutcome sessionFinish(PlaySession *session, unsigned long now, sessionOutcome outcome)
+{
+    SessionResult *result = &session->result;
+
+    configLeds(0); //Switch off LEDs and buzzer once song is complete
+    BuzzerOff();
+
+    result->outcome = outcome;
+    result->score = session->size - (result->errors + result->misses + result->partials);
+    result->duration = now - session->sessionStart;
+    return outcome;
+}
+
+/*
+ * Prepares a session to play song from tick now
+ */
+void sessionStart(PlaySession *session, const Note *song, int size, unsigned long now)
+{
+    session->song = song;
+    session->size = size;
+    session->note = 0;
+    session->noteStart = now;
+    session->sessionStart = now;
+    session->pass = 0;
+
+    session->result.outcome = SESSION_RUNNING;
+    session->result.hits = 0;
+    session->result.misses = 0;
+    session->result.errors = 0;
+    session->result.partials = 0;
+    session->result.score = size;
+    session->result.duration = 0;
+    session->result.reactionMin = 0xFFFF;
+    session->result.reactionMax = 0;
+    session->result.reactionTotal = 0;
+    session->result.reactions = 0;
+}
+
+/*
+ * Advances the session to tick now with the given external button state.
+ * Lights the LEDs for the current note, plays the correct note if its lanes
+ * are pressed or an off-sounding note if a wrong one is, and moves on
+ * once the note's duration has passed. Returns SESSION_RUNNING until the
+ * song is complete (SESSION_WON) or too many notes were missed or wrong
+ * (SESSION_LOST); after that it keeps returning the outcome.
+ */
+sessionOutcome sessionTick(PlaySession *session, unsigned long now, char buttons)
+{
+    const Note *note;
+    unsigned long elapsed;
+
+    if (session->result.outcome != SESSION_RUNNING) {
+        return session->result.outcome;
+    }
+
+    note = &session->song[session->note];
+    elapsed = now - session->noteStart;
+
+    if (elapsed < note->duration) { //Read the state of the buttons while note is played
+        PROFILE_BEGIN(PROF_NOTE_LOOP);
+        configLeds(note->led); //Set LEDs to notes, every lane of a chord
+        if (buttons & ~note->led) { //If a lane outside the note is pressed
+            BuzzerOn(NOTE_G6); //Play bad note
+            session->pass = 2;
+        } else if (buttons == note->led) { //If all of the note's lanes are pressed
+            if ((session->pass == 0) || (session->pass == 3)) { //First full press of this note
+                SessionResult *result = &session->result;
+                if (elapsed < result->reactionMin) {
+                    result->reactionMin = (unsigned int)elapsed;
+                }
+                if (elapsed > result->reactionMax) {
+                    result->reactionMax = (unsigned int)elapsed;
+                }
+                result->reactionTotal += elapsed;
+                result->reactions++;
+            }
+            setLaunchpadLeds(0x01); //Enable the green Launchpad LED
+            setLaunchpadLeds(0x00);
+            BuzzerOn(note->pitch); //Play correct note
+            session->pass = 1;
+        } else if ((buttons != 0) && (session->pass == 0)) { //Part of a chord so far
+            session->pass = 3;
+        }
+        PROFILE_END(PROF_NOTE_LOOP);
+        return SESSION_RUNNING;
+    }
+
+    //Note is over
+    if (sessionScoreNote(session)) { //If total errors are greater than 10
+        return sessionFinish(session, now, SESSION_LOST);
+    }
+
+    session->note++;
+    session->noteStart = now; //Get time mark
+    session->pass = 0;
+
+    if (session->note >= session->size) {
+        return sessionFinish(session, now, SESSION_WON);
+    }
+    return SESSION_RUNNING;
+}
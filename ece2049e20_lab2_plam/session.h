@@ -0,0 +1,54 @@
+/** session.h
+ *
+ *  Created on: Oct 19, 2026
+ *
+ * One play-through of a song. A session is started once and then advanced
+ * by sessionTick() from the main loop with the current time and button
+ * state; it never blocks, so the caller keeps control between polls. When
+ * the song ends or the player makes too many mistakes the session stops and
+ * its result record holds everything the WIN and LOSE screens need.
+ *
+ * Buttons and notes are lane masks, so a note can be a chord. A note is hit
+ * when exactly its lanes are held together and wrong as soon as a lane
+ * outside it is pressed. A chord that only ever had some of its lanes held
+ * is a partial: it does not count towards SESSION_MAX_MISTAKES but it is
+ * not scored either.
+ */
+
+#ifndef SESSION_H_
+#define SESSION_H_
+
+#include "note.h"
+
+#define SESSION_MAX_MISTAKES 10 //Wrong plus missed notes that end the song
+
+typedef enum {SESSION_RUNNING, SESSION_WON, SESSION_LOST} sessionOutcome;
+
+typedef struct {
+    sessionOutcome outcome;
+    int hits; //Notes that ended on the correct button
+    int misses; //Notes where no button was pressed
+    int errors; //Notes that ended on a wrong button
+    int partials; //Chords where only some of the lanes were pressed
+    int score; //Notes in the song minus mistakes and partial chords
+    unsigned long duration; //Ticks from start to end of the session
+    unsigned int reactionMin; //Ticks from note start to a correct first press
+    unsigned int reactionMax;
+    unsigned long reactionTotal; //Divide by reactions for the mean
+    int reactions; //Notes whose first press was correct
+} SessionResult;
+
+typedef struct {
+    const Note *song;
+    int size; //Number of notes in song
+    int note; //Index of the note being played
+    unsigned long noteStart; //Tick the current note started on
+    unsigned long sessionStart;
+    char pass; //0 = no press yet, 1 = correct, 2 = wrong, 3 = part of a chord, for the current note
+    SessionResult result;
+} PlaySession;
+
+void sessionStart(PlaySession *session, const Note *song, int size, unsigned long now);
+sessionOutcome sessionTick(PlaySession *session, unsigned long now, char buttons);
+
+#endif
@@ -0,0 +1,182 @@
+/** timebase.c
+ *
+ *  Created on: Oct 19, 2026
+ *
+ * Timer A2 tick. See timebase.h.
+ */
+
+#include <msp430.h>
+#include "timebase.h"
+#include "debounce.h"
+
+#ifndef TIMEBASE_TICKLESS
+
+static volatile unsigned long ticks = 0; //Timer ticks at 0.005 s/tick
+
+#pragma vector = TIMER2_A0_VECTOR
+__interrupt void TimerA2_ISR(void) {
+    ticks++;
+    debounceTick(); //O(1), a few logic operations for all the buttons
+    __bic_SR_register_on_exit(LPM0_bits); //Let timebaseWaitUntil() check the time
+}
+
+/*
+ * Starts the timer: ACLK, divide by 1, up mode, one interrupt per tick
+ */
+void timebaseInit(void) {
+    TA2CTL = TASSEL_1 | ID_0 | MC_1 | TACLR;
+    TA2CCR0 = TIMEBASE_TICK_COUNTS - 1;
+    TA2CCTL0 = CCIE; //Enable capture/compare interrupt
+}
+
+/*
+ * Returns the tick count. The ISR may update it between the CPU's two word
+ * reads, so read it twice and retry until both reads agree.
+ */
+unsigned long timebaseNow(void) {
+    unsigned long a, b;
+
+    do {
+        a = ticks;
+        b = ticks;
+    } while (a != b);
+    return a;
+}
+
+/*
+ * Returns the low 16 bits of the tick count. A single word read is atomic.
+ */
+uint16_t timebaseNow16(void) {
+    return *(volatile uint16_t *)&ticks; //Little endian: low word first
+}
+
+/*
+ * Sleeps in LPM0 until tick is reached. The tick ISR wakes the CPU every tick.
+ */
+void timebaseWaitUntil(unsigned long tick) {
+    while (1) {
+        __disable_interrupt();
+        if ((long)(ticks - tick) >= 0) {
+            break;
+        }
+        __bis_SR_register(LPM0_bits | GIE); //Sleep and enable interrupts in one instruction
+    }
+    __enable_interrupt();
+}
+
+#else
+
+static volatile uint16_t overflows = 0; //TA2R wraps, one every 2 s
+static unsigned long baseCounts = 0; //ACLK count that baseTicks starts on
+static unsigned long baseTicks = 0;
+
+/*
+ * Reads TA2R. ACLK is asynchronous to MCLK, so read until two reads agree.
+ */
+static uint16_t readCounter(void) {
+    uint16_t a, b;
+
+    do {
+        a = TA2R;
+        b = TA2R;
+    } while (a != b);
+    return a;
+}
+
+/*
+ * Returns the 32-bit ACLK count and moves the tick base up to it.
+ * Must be called with interrupts disabled.
+ */
+static unsigned long advance(void) {
+    uint16_t hi = overflows;
+    uint16_t lo = readCounter();
+    unsigned long counts, whole;
+
+    if ((TA2CTL & TAIFG) && lo < 0x8000) { //Wrapped, but the ISR has not run yet
+        hi++;
+    }
+    counts = ((unsigned long)hi << 16) | lo;
+
+    //Only whole ticks move the base, so no count is ever lost to rounding
+    whole = (counts - baseCounts) / TIMEBASE_TICK_COUNTS;
+    baseTicks += whole;
+    baseCounts += whole * TIMEBASE_TICK_COUNTS;
+    return counts;
+}
+
+#pragma vector = TIMER2_A1_VECTOR
+__interrupt void TimerA2_Overflow_ISR(void) {
+    if (TA2IV == TA2IV_TAIFG) { //Reading TA2IV clears the flag
+        overflows++;
+        advance(); //Keeps the division in advance() small
+        __bic_SR_register_on_exit(LPM3_bits);
+    }
+}
+
+#pragma vector = TIMER2_A0_VECTOR
+__interrupt void TimerA2_ISR(void) {
+    TA2CCTL0 = 0; //One shot: the deadline has been reached
+    __bic_SR_register_on_exit(LPM3_bits);
+}
+
+/*
+ * Starts the timer: ACLK, divide by 1, continuous mode, overflow interrupt only
+ */
+void timebaseInit(void) {
+    TA2CCTL0 = 0;
+    TA2CTL = TASSEL_1 | ID_0 | MC_2 | TACLR | TAIE;
+}
+
+/*
+ * Returns the tick count
+ */
+unsigned long timebaseNow(void) {
+    unsigned short sr = __get_SR_register();
+    unsigned long now;
+
+    __disable_interrupt();
+    advance();
+    now = baseTicks;
+    if (sr & GIE) {
+        __enable_interrupt();
+    }
+    return now;
+}
+
+/*
+ * Returns the low 16 bits of the tick count
+ */
+uint16_t timebaseNow16(void) {
+    return (uint16_t)timebaseNow();
+}
+
+/*
+ * Sleeps in LPM3 until tick is reached. TA2CCR0 is programmed for the
+ * deadline; the overflow interrupt also wakes the CPU every 2 s, which
+ * covers deadlines more than one counter wrap away.
+ */
+void timebaseWaitUntil(unsigned long tick) {
+    unsigned long deadline;
+
+    while (1) {
+        __disable_interrupt();
+        advance();
+        if ((long)(baseTicks - tick) >= 0) {
+            break;
+        }
+        deadline = baseCounts + (tick - baseTicks) * TIMEBASE_TICK_COUNTS;
+        TA2CCR0 = (uint16_t)deadline;
+        TA2CCTL0 = CCIE; //Also clears a stale CCIFG
+
+        //If the deadline passed while it was being programmed, do not wait a full wrap for it
+        if ((long)(advance() - deadline) >= 0) {
+            TA2CCTL0 = 0;
+            continue;
+        }
+        __bis_SR_register(LPM3_bits | GIE); //Sleep and enable interrupts in one instruction
+    }
+    TA2CCTL0 = 0;
+    __enable_interrupt();
+}
+
+#endif /* TIMEBASE_TICKLESS */
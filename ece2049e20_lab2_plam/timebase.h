@@ -0,0 +1,46 @@
+/** timebase.h
+ *
+ *  Created on: Oct 19, 2026
+ *
+ * System tick on Timer A2, one tick = TIMEBASE_TICK_COUNTS periods of ACLK
+ * (~5 ms). Two implementations share the same API:
+ *
+ *  - Periodic (default): TA2 interrupts every tick and the ISR counts.
+ *  - Tickless (TIMEBASE_TICKLESS): TA2 free-runs and the tick is computed
+ *    from the counter. The only interrupts are one overflow every 2 s and,
+ *    while someone is sleeping in timebaseWaitUntil(), one compare at the
+ *    deadline.
+ *
+ * timebaseNow() returns a consistent 32-bit tick even though the CPU reads
+ * it 16 bits at a time. timebaseNow16() returns the low half; in periodic
+ * mode that is a single word read with no retry. Compare 16-bit stamps with
+ * TIMEBASE_ELAPSED16(), which stays correct across a wrap as long as the
+ * interval is under 65536 ticks (~5.5 min).
+ *
+ * timebaseWaitUntil() sleeps until a tick is reached: LPM0 between tick
+ * interrupts in periodic mode, LPM3 until the compare in tickless mode.
+ * Both need GIE.
+ *
+ * The periodic ISR also samples the buttons for debounce.c every tick.
+ */
+
+#ifndef TIMEBASE_H_
+#define TIMEBASE_H_
+
+#include <stdint.h>
+
+// Uncomment to stop the 5 ms interrupt and derive ticks from TA2R
+//#define TIMEBASE_TICKLESS
+
+#define TIMEBASE_ACLK_HZ        32768UL
+#define TIMEBASE_TICK_COUNTS    164         // 32768 Hz * 0.005 s, rounded up
+#define TIMEBASE_TICK_MS        5
+
+#define TIMEBASE_ELAPSED16(now, then)   ((uint16_t)((uint16_t)(now) - (uint16_t)(then)))
+
+void timebaseInit(void);
+unsigned long timebaseNow(void);
+uint16_t timebaseNow16(void);
+void timebaseWaitUntil(unsigned long tick);
+
+#endif
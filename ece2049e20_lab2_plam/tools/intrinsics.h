@@ -0,0 +1,18 @@
+/** intrinsics.h
+ *
+ *  Created on: Oct 19, 2026
+ *
+ * Stand-in for the compiler's intrinsics header, included by
+ * utils/debug_assert.h. DEBUG_BREAK() does nothing on the host; the other
+ * intrinsics the host tools need are in msp430.h.
+ */
+
+#ifndef HOST_INTRINSICS_H_
+#define HOST_INTRINSICS_H_
+
+#include "msp430.h"
+
+#define _op_code(x)         ((void)(x))
+#define _no_operation()     ((void)0)
+
+#endif
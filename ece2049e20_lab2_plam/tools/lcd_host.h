@@ -0,0 +1,58 @@
+/** lcd_host.h
+ *
+ *  Created on: Oct 19, 2026
+ *
+ * Host stand-in for the Sharp128x128 HAL with a model of the SPI bus. Host
+ * tools link it in place of LcdDriver/sharp128/HAL_MSP_EXP430F5529_Sharp128x128.c
+ * and build the real driver against it, so flushes, clears and VCOM
+ * toggles run the same code as on target. With LCD_DOUBLE_BUFFER enabling
+ * the TX interrupt runs the driver's interrupt handler until it disables
+ * the interrupt again, so a flush has been sent when Graphics_flushBuffer()
+ * returns.
+ *
+ * Every byte written and every chip select frame is counted. A frame whose
+ * command byte is SHARP_LCD_CMD_WRITE_LINE is a flush: its traffic is kept
+ * in g_lcdBusFlush, and the traffic since the previous flush ended (clears
+ * and VCOM toggles included) in g_lcdBusFrame.
+ *
+ * lcdHostProjectUs() turns traffic into on-target time. Each byte costs the
+ * longer of its 8 SPI bit times and the CPU cycles spent feeding the TX
+ * buffer, which overlap since TXBUF is double buffered. Each frame adds the
+ * thSCS hold the driver spins for with __delay_cycles(). The clocks and the
+ * cycles per byte are variables, so a tool can project a clock change
+ * without a rebuild.
+ */
+
+#ifndef LCD_HOST_H_
+#define LCD_HOST_H_
+
+#include <stdint.h>
+#include "peripherals.h"
+
+// CPU cycles to feed one byte: call, UCTXIFG poll, store and return for the
+// blocking flush; interrupt entry, Sharp128x128_txReady() and reti for the
+// interrupt driven one
+#ifdef LCD_DOUBLE_BUFFER
+#define LCD_HOST_BYTE_CYCLES    40
+#else
+#define LCD_HOST_BYTE_CYCLES    14
+#endif
+
+typedef struct {
+    uint32_t bytes;         // Bytes written to the SPI TX buffer
+    uint32_t frames;        // Chip select frames
+    uint32_t holdCycles;    // MCLK cycles spent holding CS after the last byte
+} LcdBusStats;
+
+extern uint32_t g_lcdBusSpiHz;      // Defaults to LCD_SPI_ACTUAL_FREQ_HZ
+extern uint32_t g_lcdBusCpuHz;      // Defaults to MCLK_FREQ_HZ
+extern uint32_t g_lcdBusByteCycles; // Defaults to LCD_HOST_BYTE_CYCLES
+
+extern LcdBusStats g_lcdBusFlush;   // The most recent flush
+extern LcdBusStats g_lcdBusFrame;   // Everything up to the end of the most recent flush
+extern uint32_t g_lcdBusFlushes;
+
+void lcdHostReset(void);
+uint32_t lcdHostProjectUs(const LcdBusStats *stats);
+
+#endif /* LCD_HOST_H_ */
@@ -0,0 +1,46 @@
+/** msp430.h
+ *
+ *  Created on: Oct 19, 2026
+ *
+ * Stand-in for the device header, so the display and graphics headers can
+ * be included by the host tools in this directory. Defined here are the UCS
+ * field values clock.h selects between, with the MSP430F5529 values, for
+ * tools/check_clock.c, and the intrinsics the Sharp128x128 driver calls,
+ * for tools/lcd_host.c. The only registers are the two LED ports lab 1's
+ * game.c sets, as plain variables that bench/game_flushes.c defines.
+ * Interrupts are always enabled and never pending on the host, and
+ * __delay_cycles() is counted by the bus model instead of spun.
+ */
+
+#ifndef HOST_MSP430_H_
+#define HOST_MSP430_H_
+
+#define DCORSEL_5   (0x0050)
+#define DCORSEL_7   (0x0070)
+
+#define DIVS__1     (0x0000)
+#define DIVS__2     (0x0010)
+#define DIVS__4     (0x0020)
+#define DIVS__8     (0x0030)
+#define DIVS__16    (0x0040)
+#define DIVS__32    (0x0050)
+
+#define GIE         (0x0008)
+
+#define BIT0        (0x0001)
+#define BIT7        (0x0080)
+
+extern volatile unsigned char P1OUT;
+extern volatile unsigned char P4OUT;
+
+#define __get_SR_register()     ((unsigned short)GIE)
+#define __bis_SR_register(x)    ((void)(x))
+#define __bic_SR_register(x)    ((void)(x))
+#define __disable_interrupt()   ((void)0)
+#define __enable_interrupt()    ((void)0)
+#define __no_operation()        ((void)0)
+#define __delay_cycles(n)       lcdHostDelayCycles(n)
+
+void lcdHostDelayCycles(unsigned long cycles);
+
+#endif
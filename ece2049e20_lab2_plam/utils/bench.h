@@ -0,0 +1,55 @@
+/*
+ * bench.h
+ *
+ *  Created on: Oct 19, 2026
+ *
+ * Micro-benchmark harness built on the profiling timebase. Each workload is
+ * timed per iteration and reported over the profiling UART as one JSON
+ * object per line, e.g.
+ *
+ *  {"bench":"flush","n":16,"min_us":16800,"mean_us":16812,"max_us":16840}
+ *
+ * With the in-tree graphics core (GFX_CORE in gfx.h) the drawing workloads
+ * also run through grlib.lib under a grlib_ prefix, and the size of the
+ * core's code is reported as {"size":"gfx_text","bytes":...}. Every asset in
+ * assets.h gets a {"asset":...} line with its packed size and a draw_asset_
+ * workload that times its decode.
+ *
+ * The suite only measures. The regression check against a recorded
+ * baseline is done by the host build of the suite in bench/, which runs the
+ * same workloads without a board; see bench/bench_host.h.
+ */
+
+#ifndef BENCH_H_
+#define BENCH_H_
+
+#include "utils/profile.h"
+
+// Uncomment to run the benchmark suite at startup instead of the game
+//#define BENCH_ENABLE
+
+#if defined(BENCH_ENABLE) && !defined(PROFILE_ENABLE)
+#error "BENCH_ENABLE requires PROFILE_ENABLE in utils/profile.h"
+#endif
+
+/*
+ * Times iterations executions of code and reports them as name
+ */
+#define BENCH(name, iterations, code) do { \
+    ProfileEntry _e; \
+    uint16_t _i; \
+    profileClear(&_e); \
+    for (_i = 0; _i < (iterations); _i++) { \
+        profileTicks _t0 = PROFILE_NOW(); \
+        code; \
+        profileRecord(&_e, PROFILE_NOW() - _t0); \
+    } \
+    benchReport((name), &_e); \
+} while (0)
+
+void benchBegin(void);
+void benchEnd(void);
+void benchReport(const char *name, const ProfileEntry *e);
+void benchGraphics(void);
+
+#endif /* BENCH_H_ */
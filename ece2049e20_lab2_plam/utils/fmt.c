@@ -0,0 +1,86 @@
+/** fmt.c
+ *
+ *  Created on: Oct 19, 2026
+ *
+ * Integer formatters for display text. See fmt.h.
+ */
+
+#include "fmt.h"
+
+static const uint16_t pow10[] = {10000, 1000, 100, 10};
+static const char hexDigits[] = "0123456789abcdef";
+
+/*
+ * Writes value in decimal, right aligned in a field of at least width
+ * characters padded on the left with pad. buf must hold the larger of
+ * width and 5 characters, plus the NUL.
+ */
+int fmt_u16_pad(unsigned char *buf, uint16_t value, int width, char pad)
+{
+    unsigned char digits[5];
+    unsigned char digit;
+    int count = 0;
+    int i, pos;
+
+    //Every digit above the units by repeated subtraction, at most 9 per
+    //digit, dropping leading zeros
+    for (i = 0; i < (int)(sizeof(pow10) / sizeof(pow10[0])); i++) {
+        digit = '0';
+        while (value >= pow10[i]) {
+            value -= pow10[i];
+            digit++;
+        }
+        if ((digit != '0') || (count != 0)) {
+            digits[count++] = digit;
+        }
+    }
+    digits[count++] = '0' + value; //The units digit is always written
+
+    pos = 0;
+    while (width-- > count) {
+        buf[pos++] = pad;
+    }
+    for (i = 0; i < count; i++) {
+        buf[pos++] = digits[i];
+    }
+    buf[pos] = '\0';
+    return pos;
+}
+
+/*
+ * Writes value in decimal. buf must hold FMT_U16_SIZE characters.
+ */
+int fmt_u16(unsigned char *buf, uint16_t value)
+{
+    return fmt_u16_pad(buf, value, 0, ' ');
+}
+
+/*
+ * Writes value in decimal with a leading '-' if negative. buf must hold
+ * FMT_I16_SIZE characters.
+ */
+int fmt_i16(unsigned char *buf, int16_t value)
+{
+    if (value < 0) {
+        //Negated in unsigned arithmetic so -32768 converts correctly
+        *buf = '-';
+        return 1 + fmt_u16(buf + 1, (uint16_t)0 - (uint16_t)value);
+    }
+    return fmt_u16(buf, (uint16_t)value);
+}
+
+/*
+ * Writes exactly digits (1 to 4) lower case hex digits of value, leading
+ * zeros included and no prefix
+ */
+int fmt_hex16(unsigned char *buf, uint16_t value, int digits)
+{
+    int i;
+
+    for (i = digits - 1; i >= 0; i--) {
+        buf[i] = hexDigits[value & 0xF];
+        value >>= 4;
+    }
+    buf[digits] = '\0';
+    return digits;
+}
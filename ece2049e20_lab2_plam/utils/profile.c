@@ -0,0 +1,241 @@
+/*
+ * profile.c
+ *
+ *  Created on: Oct 19, 2026
+ *
+ * Probe table, timer setup and report output for profile.h. The table can
+ * be dumped to the LCD or, on target, to the LaunchPad backchannel UART
+ * (USCI_A1, P4.4 TXD) as one line per probe:
+ *
+ *     name count min mean max     (all times in microseconds)
+ */
+
+#ifndef __MSP430__
+#define _POSIX_C_SOURCE 199309L
+#endif
+
+#include "profile.h"
+
+#ifdef PROFILE_ENABLE
+
+#include "peripherals.h"
+#ifndef __MSP430__
+#include <stdio.h>
+#include <time.h>
+#endif
+
+#define PROFILE_UART_BAUD   9600UL
+
+// UCA1 baud rate divider and modulation for low-frequency mode (UCOS16 = 0)
+#define PROFILE_UART_BR     (SMCLK_FREQ_HZ / PROFILE_UART_BAUD)
+#define PROFILE_UART_BRS    ((((SMCLK_FREQ_HZ * 16UL) / PROFILE_UART_BAUD + 1) / 2) - (PROFILE_UART_BR * 8UL))
+
+// Four character names so a full row fits on the 128 pixel panel
+static const char * const probeNames[PROF_NUM_PROBES] = {
+    "FLSH",
+    "CLR ",
+    "STR ",
+    "EVAL",
+    "NOTE",
+    "HWAY",
+    "CARD",
+};
+
+ProfileEntry g_profile[PROF_NUM_PROBES];
+
+/*
+ * Converts v to decimal right-aligned in a field of width characters.
+ * Returns the number of characters written, not including the terminator.
+ */
+int profileFormatU32(char *buf, uint32_t v, int width)
+{
+    char tmp[10];
+    int n = 0;
+    int i = 0;
+
+    do {
+        tmp[n++] = '0' + (v % 10);
+        v /= 10;
+    } while (v != 0);
+
+    while (width-- > n) {
+        buf[i++] = ' ';
+    }
+    while (n > 0) {
+        buf[i++] = tmp[--n];
+    }
+    buf[i] = '\0';
+    return i;
+}
+
+/*
+ * Clears the statistics of a single entry
+ */
+void profileClear(ProfileEntry *e)
+{
+    e->count = 0;
+    e->min = (profileTicks)~0;
+    e->max = 0;
+    e->total = 0;
+}
+
+/*
+ * Clears every accumulated statistic
+ */
+void profileReset(void)
+{
+    int i;
+    for (i = 0; i < PROF_NUM_PROBES; i++) {
+        profileClear(&g_profile[i]);
+    }
+}
+
+/*
+ * Starts the free-running timebase and clears the table.
+ * Timer A0 is otherwise unused by both labs.
+ */
+void profileInit(void)
+{
+#ifdef __MSP430__
+    TA0CTL = TACLR;
+    TA0EX0 = TAIDEX_7;                      // Divide by 8 ...
+    TA0CTL = TASSEL_2 | ID_3 | MC_2;        // ... and by 8 again, SMCLK, continuous mode
+#endif
+    profileReset();
+}
+
+/*
+ * Adds one measured interval to an entry
+ */
+void profileRecord(ProfileEntry *e, profileTicks elapsed)
+{
+    if (e->count != 0xFFFF) {
+        e->count++;
+        e->total += elapsed;
+    }
+    if (elapsed < e->min) {
+        e->min = elapsed;
+    }
+    if (elapsed > e->max) {
+        e->max = elapsed;
+    }
+}
+
+/*
+ * Closes the interval opened by PROFILE_BEGIN(id). Unsigned subtraction
+ * keeps the result correct across one timer wrap.
+ */
+void profileEnd(profileProbe id, profileTicks now)
+{
+    profileRecord(&g_profile[id], now - g_profile[id].start);
+}
+
+/*
+ * Builds the report line for one probe. Returns 0 if the probe never ran.
+ */
+static int profileLine(char *line, int id, int full)
+{
+    const ProfileEntry *e = &g_profile[id];
+    const char *name = probeNames[id];
+    int i = 0;
+
+    if (e->count == 0) {
+        return 0;
+    }
+
+    while (*name) {
+        line[i++] = *name++;
+    }
+    if (full) {
+        i += profileFormatU32(&line[i], e->count, 6);
+        i += profileFormatU32(&line[i], PROFILE_TICKS_TO_US(e->min), 7);
+    }
+    i += profileFormatU32(&line[i], PROFILE_TICKS_TO_US(e->total / e->count), 7);
+    i += profileFormatU32(&line[i], PROFILE_TICKS_TO_US(e->max), 7);
+    return i;
+}
+
+/*
+ * Draws "name mean max" for every probe that ran, one row per probe
+ */
+void profileDumpLcd(void)
+{
+    char line[40];
+    int id;
+    int y = 0;
+
+    Graphics_clearDisplay(&g_sContext);
+    Graphics_drawString(&g_sContext, (uint8_t *)"PROF    mean    max", AUTO_STRING_LENGTH, 0, y, OPAQUE_TEXT);
+    for (id = 0; id < PROF_NUM_PROBES; id++) {
+        if (profileLine(line, id, 0) != 0) {
+            y += 10;
+            Graphics_drawString(&g_sContext, (uint8_t *)line, AUTO_STRING_LENGTH, 0, y, OPAQUE_TEXT);
+        }
+    }
+    Graphics_flushBuffer(&g_sContext);
+}
+
+#ifdef __MSP430__
+/*
+ * Configures USCI_A1 for UART on P4.4 (TXD) / P4.5 (RXD),
+ * PROFILE_UART_BAUD 8N1
+ */
+void profileUartInit(void)
+{
+    P4SEL |= BIT4 | BIT5;
+    UCA1CTL1 |= UCSWRST;
+    UCA1CTL1 = UCSSEL__SMCLK | UCSWRST;
+    UCA1CTL0 = 0;
+    UCA1BR0 = PROFILE_UART_BR & 0xFF;
+    UCA1BR1 = (PROFILE_UART_BR >> 8) & 0xFF;
+    UCA1MCTL = (PROFILE_UART_BRS << 1) & UCBRS_7;
+    UCA1CTL1 &= ~UCSWRST;
+}
+
+/*
+ * Blocking write of a string to the UART
+ */
+void profileUartPuts(const char *s)
+{
+    while (*s) {
+        while (!(UCA1IFG & UCTXIFG));
+        UCA1TXBUF = *s++;
+    }
+}
+#else
+profileTicks profileHostNow(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (profileTicks)(ts.tv_sec * 1000000UL + ts.tv_nsec / 1000);
+}
+
+void profileUartInit(void)
+{
+}
+
+void profileUartPuts(const char *s)
+{
+    fputs(s, stdout);
+}
+#endif /* __MSP430__ */
+
+/*
+ * Writes the full table to the UART
+ */
+void profileDumpUart(void)
+{
+    char line[40];
+    int id;
+
+    profileUartInit();
+    profileUartPuts("name count    min   mean    max\r\n");
+    for (id = 0; id < PROF_NUM_PROBES; id++) {
+        if (profileLine(line, id, 1) != 0) {
+            profileUartPuts(line);
+            profileUartPuts("\r\n");
+        }
+    }
+}
+
+#endif /* PROFILE_ENABLE */
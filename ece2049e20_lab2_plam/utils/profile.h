@@ -0,0 +1,94 @@
+/*
+ * profile.h
+ *
+ *  Created on: Oct 19, 2026
+ *
+ * Lightweight cycle profiling. Each probe ID owns a slot in a fixed table
+ * that accumulates call count and min/max/total elapsed time between
+ * PROFILE_BEGIN(id) and PROFILE_END(id). On target the timestamps come from
+ * Timer A0 running free from SMCLK; on a host build they come from
+ * clock_gettime(). With PROFILE_ENABLE undefined every probe compiles away.
+ */
+
+#ifndef PROFILE_H_
+#define PROFILE_H_
+
+#include <stdint.h>
+
+// Uncomment to build with profiling probes
+//#define PROFILE_ENABLE
+
+// Probe IDs. Add new probes before PROF_NUM_PROBES and give them a
+// name in profile.c.
+typedef enum {
+    PROF_FLUSH = 0,         // Sharp128x128_Flush
+    PROF_CLEAR_SCREEN,      // Sharp128x128_ClearScreen
+    PROF_DRAW_STRING,       // Graphics_drawString* at the call site
+    PROF_EVAL_HAND,         // evalHand (lab 1)
+    PROF_NOTE_LOOP,         // One poll of the playSong note loop (lab 2)
+    PROF_HIGHWAY,           // One highwayRender frame (lab 2)
+    PROF_DRAW_CARD,         // cardDraw (lab 1)
+    PROF_NUM_PROBES
+} profileProbe;
+
+#ifdef __MSP430__
+#include <msp430.h>
+#include "clock.h"
+
+typedef uint16_t profileTicks;
+
+// Timer A0 input divider: ID = /8, TAIDEX = /8
+#define PROFILE_TIMER_DIV   64
+#define PROFILE_TICK_HZ     (SMCLK_FREQ_HZ / PROFILE_TIMER_DIV)
+#define PROFILE_NOW()       (TA0R)
+#else
+typedef uint32_t profileTicks;
+
+#define PROFILE_TICK_HZ     1000000UL
+#define PROFILE_NOW()       profileHostNow()
+profileTicks profileHostNow(void);
+#endif
+
+// Converts a tick count to microseconds without overflowing 32 bits
+#define PROFILE_TICKS_TO_US(t)  (((uint32_t)(t) * 1000UL) / (PROFILE_TICK_HZ / 1000UL))
+
+typedef struct {
+    uint16_t count;         // Number of completed BEGIN/END pairs
+    profileTicks min;       // Shortest interval seen
+    profileTicks max;       // Longest interval seen
+    uint32_t total;         // Sum of all intervals, for the mean
+    profileTicks start;     // Timestamp of the pending BEGIN
+} ProfileEntry;
+
+#ifdef PROFILE_ENABLE
+
+extern ProfileEntry g_profile[PROF_NUM_PROBES];
+
+#define PROFILE_BEGIN(id)   (g_profile[(id)].start = PROFILE_NOW())
+#define PROFILE_END(id)     profileEnd((id), PROFILE_NOW())
+
+void profileInit(void);
+void profileReset(void);
+void profileClear(ProfileEntry *e);
+void profileRecord(ProfileEntry *e, profileTicks elapsed);
+void profileEnd(profileProbe id, profileTicks now);
+void profileDumpLcd(void);
+void profileDumpUart(void);
+
+void profileUartInit(void);
+void profileUartPuts(const char *s);
+int profileFormatU32(char *buf, uint32_t v, int width);
+
+#else
+
+#define PROFILE_BEGIN(id)   do {} while (0)
+#define PROFILE_END(id)     do {} while (0)
+
+#define profileInit()       do {} while (0)
+#define profileReset()      do {} while (0)
+#define profileDumpLcd()    do {} while (0)
+#define profileDumpUart()   do {} while (0)
+
+#endif /* PROFILE_ENABLE */
+
+#endif /* PROFILE_H_ */
@@ -21,6 +21,7 @@
 // This is part of revision 10636 of the Stellaris Firmware Development Package.
 //
 //*****************************************************************************
+#include <stdarg.h>
 #include <string.h>
 #include "debug_assert.h"
 